@@ -9,28 +9,75 @@
 #include "ResourceManager.h"
 #include <vector>
 #include <string>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
 #include <iostream>
 #include <SFML/Graphics.hpp>
 #include "VariableManager.h"
 #include "../vendors/ai/NeuralNetwork/NeuralNetwork.h"
 #include "Car.h"
-
-struct Player {
-    std::vector<float> rayDistances;
-    std::vector<sf::VertexArray> rays;
-    std::vector<sf::CircleShape> collisionMarkers;
-    int nextCheckpoint = 0;
-    bool isDead = false;
-    float points = 0.0f;
-    Car car;
-};
+#include "CarBatch.h"
+#include "Population.h"
+#include "ThreadPool.h"
+#include "TripleBuffer.h"
 
 class AiGameState : public GameStateParent {
 private:
-    std::vector<Player> players;
+    Population population;
+    ThreadPool threadPool;
+    int networkCount = VariableManager::getNetworksAmount();
+    // Selects the random streams derived from the run seed
+    int island = 0;
     carData carTemplate;
-
-    float variableDt = 0.1f;
+    sf::Sprite carSprite;
+
+    // Everything render needs from one moment of the simulation, entry k belongs to car cars[k]
+    struct Snapshot {
+        std::vector<int> cars;
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> rotation;
+        std::vector<float> score;
+        std::vector<sf::Vector2f> rayHits;  // cars.size() * rayCount, empty while SHOW_RAYS is off
+        int rayCount = 0;
+        int generation = 0;
+        int aliveCars = 0;
+        float stepsPerSecond = 0.0f;
+    };
+    TripleBuffer<Snapshot> snapshots;
+
+    // THREADED_SIMULATION: the steps run on simulationThread, the window thread only draws snapshots
+    std::thread simulationThread;
+    // Held for every step, input that changes the simulation takes it in between
+    std::mutex simulationMutex;
+    std::atomic<bool> simulationRunning{false};
+    std::atomic<bool> simulationPaused{true};
+    std::atomic<bool> inputWaiting{false};
+
+    CarBatch carBatch;
+    // Snapshot entries drawn this frame, chosen by RENDER_POLICY and SHOW_CARS_FIRST
+    std::vector<int> shownCars;
+    // Random key per car for the sample policy, drawn again every generation, not from the seeded streams
+    std::vector<float> sampleKey;
+    int sampleGeneration = -1;
+    std::mt19937 renderRandom{std::random_device{}()};
+
+    // Fixed, so a run repeats exactly with the same seed
+    float timestep = VariableManager::getSimulationTimestep();
+    // Windowed mode only, changed with shift and the mouse wheel or adapted to TARGET_FRAME_TIME
+    int stepsPerFrame = 1;
+    float stepCost = 0.0f;      // Seconds per simulation step, moving average
+    float renderCost = 0.0f;    // Seconds of the last render
+    // Measured over about one second of wall time
+    float stepsPerSecond = 0.0f;
+    int stepsCounted = 0;
+    std::chrono::high_resolution_clock::time_point stepsCountedSince = std::chrono::high_resolution_clock::now();
+    // Simulated seconds since the generation started
+    float generationTime = 0.0f;
 
     bool forceReset = false;
 
@@ -38,27 +85,70 @@ private:
 
     int currentGen = 0;
     int deadCars = 0;
+    float lastBestScore = 0.0f;
 
     NeuralNetwork network;
+    // Empty for truncation, which runs completely on the device
+    std::unique_ptr<SelectionStrategy> selection;
 
     sf::Font textFont;
 
     std::vector<sf::Vector2f> checkpoints;
+    std::string checkpointFile;
 
+    void initializeNetwork();
     void initializeCar() override;
-    void initializeRays();
     void initializeRayAngles();
-    void performRaycasts(Game &game);
+    void performRaycasts();
+    void performRaycasts(int begin, int end);
+
+    void loadCheckpoints(const std::string &levelFile);
+    void saveCheckpoints();
 
     void render(Game &game) override;
+    void selectShownCars(const Snapshot &snapshot);
+    // Reduces entries to the count with the highest key, highest first
+    static void keepBest(std::vector<int> &entries, int count, const std::vector<float> &key);
+    float currentScore(int playerIDX) const;
+    void publishSnapshot();
+    void countSteps(int steps);
+
+    void simulationLoop();
+    void stopSimulation();
+    // Empty lock without a simulation thread
+    std::unique_lock<std::mutex> lockSimulation();
     void update(Game &game) override;
     void handleInput(Game &game) override;
 
     void updateAI();
+    // As many steps as fit next to the rendering into the target frame time
+    int adaptiveStepCount() const;
+    void updateCars();
+    int updateCars(int begin, int end);
+    // Stagnation timeout and minimum progress rate, see VariableManager
+    bool shouldCull(int playerIDX) const;
 public:
     AiGameState(Game &game, const std::string &levelFile);
-
-    explicit AiGameState(Game &game) : GameStateParent(game) {
+    // Headless constructor, does not need a window or any OpenGL resources.
+    // networks and threads default to NETWORKS_AMOUNT and THREADS, island selects the random streams.
+    AiGameState(const std::string &levelFile, carData &carTemplate, int networks = 0, int threads = -1, int island = 0);
+    ~AiGameState();
+
+    // Simulation interface, used by update() and the headless trainer
+    void simulationStep();
+    bool isGenerationFinished() const;
+    std::vector<float> calculateScores();
+    void nextGeneration();
+    // Starts the current generation over with the networks as they are, without breeding
+    void restartGeneration();
+    void requestReset() { forceReset = true; }
+
+    int getCurrentGeneration() const { return currentGen; }
+    int getAliveCars() const { return population.size() - deadCars; }
+    float getLastBestScore() const { return lastBestScore; }
+    NeuralNetwork &getNetwork() { return network; }
+
+    explicit AiGameState(Game &game) : GameStateParent(game), threadPool(VariableManager::getThreads()) {
         initializeCar();
     }
 };
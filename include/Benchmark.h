@@ -0,0 +1,29 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef INTELLIDRIVE_BENCHMARK_H
+#define INTELLIDRIVE_BENCHMARK_H
+
+#include <vector>
+#include <chrono>
+#include <iostream>
+
+#include "VariableManager.h"
+#include "../vendors/ai/NeuralNetwork/NeuralNetwork.h"
+
+// Command line measurements, started with "--benchmark <name>"
+class Benchmark {
+private:
+    // Bytes held by the ArrayFire memory manager after a garbage collection
+    static size_t allocatedBytes();
+
+public:
+    // Compares feed_forward against feed_forward_tiled for the configured topology
+    static int inference(int networks, const std::vector<int> &batchSizes, int iterations = 20);
+
+    // Parses "--benchmark inference [--networks N]"
+    static int runFromArguments(int argc, char *argv[]);
+};
+
+#endif //INTELLIDRIVE_BENCHMARK_H
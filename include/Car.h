@@ -10,6 +10,7 @@
 struct carData {
     std::string name;
     sf::Texture carTexture;
+    sf::Vector2u carTextureSize;
     float MaxSpeed;
     float Handling;
     float Acceleration;
@@ -40,8 +41,14 @@ public:
     // New setters and getters
     void setAcceleration(float value);
     void setAngularAcceleration(float value);
+    sf::Vector2f getVelocity() const { return velocity; };
+    void setVelocity(const sf::Vector2f &value) { velocity = value; };
+    float getAngularVelocity() const { return angular_velocity; };
+    void setAngularVelocity(float value) { angular_velocity = value; };
     float getAccelerationConstant() const;
     float getAngularAccelerationConstant() const;
+    float getMaxSpeed() const { return max_speed; };
+    float getFrictionCoefficient() const { return friction_coefficient; };
 
     float getDistanceMovedBackwards() {return distanceMovedBackwards;};
     float getDistanceRotated() {return distanceRotated;};
@@ -0,0 +1,45 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef INTELLIDRIVE_CARBATCH_H
+#define INTELLIDRIVE_CARBATCH_H
+
+#include <SFML/Graphics.hpp>
+
+// Every visible car of a population as one vertex array sharing the car texture,
+// plus the debug rays, their hit markers and cars drawn as points in one array each.
+class CarBatch {
+private:
+    sf::VertexArray cars{sf::Quads};
+    sf::VertexArray rays{sf::Lines};
+    sf::VertexArray markers{sf::Quads};
+    sf::VertexArray points{sf::Points};
+
+    const sf::Texture *texture = nullptr;
+    // Corners of the sprite around its position before the rotation, and their texture coordinates
+    sf::Vector2f corners[4];
+    sf::Vector2f texCoords[4];
+    sf::Color color;
+    // Covers the car at any rotation, used for culling
+    float radius = 0.0f;
+    sf::FloatRect visible;
+
+    bool isVisible(const sf::Vector2f &position) const;
+
+public:
+    CarBatch() = default;
+
+    // Takes texture, rect, origin, scale and color from the sprite and the visible area from the view
+    void begin(const sf::Sprite &sprite, const sf::View &view);
+    // Returns false if the car is outside of the view and was skipped
+    bool addCar(const sf::Vector2f &position, float rotation);
+    // A single pixel instead of the sprite, for large crowds, culled like addCar
+    bool addPoint(const sf::Vector2f &position);
+    void addRay(const sf::Vector2f &start, const sf::Vector2f &end);
+    void draw(sf::RenderTarget &target) const;
+
+    [[nodiscard]] size_t getCarCount() const { return cars.getVertexCount() / 4 + points.getVertexCount(); }
+};
+
+#endif //INTELLIDRIVE_CARBATCH_H
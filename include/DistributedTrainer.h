@@ -0,0 +1,66 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef INTELLIDRIVE_DISTRIBUTEDTRAINER_H
+#define INTELLIDRIVE_DISTRIBUTEDTRAINER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <iostream>
+
+#include "AiGameState.h"
+#include "HeadlessTrainer.h"
+#include "RunManifest.h"
+#include "VariableManager.h"
+#include "../vendors/ai/NeuralNetwork/NeuralNetwork.h"
+#include "../vendors/ai/Selection/Selection.h"
+
+// The coordinator owns the population and breeds it, worker processes simulate shards of it.
+// They talk over a Unix domain socket, so this only runs on POSIX systems.
+class DistributedTrainer {
+private:
+    enum class MessageType : uint32_t {
+        Hello,      // worker -> coordinator, count is the worker index
+        Evaluate,   // coordinator -> worker, count networks in the layout of NeuralNetwork::export_networks
+        Fitness,    // worker -> coordinator, count scores of the AiGameState scoring
+        Stop        // coordinator -> worker
+    };
+
+    struct MessageHeader {
+        uint32_t type;
+        uint32_t count;
+        uint64_t bytes;
+    };
+
+    std::string levelFile;
+    std::string savePath;
+    int generations;
+    int maxStepsPerGeneration;
+    int workers;
+    unsigned int seed = 0;
+
+    static bool sendMessage(int socket, MessageType type, uint32_t count, const std::vector<float> &payload);
+    static bool receiveMessage(int socket, MessageHeader &header, std::vector<float> &payload);
+
+    // Waits for the next worker to connect, -1 if a worker process exited first or none came
+    int acceptWorker(int listener, const std::vector<int> &pids);
+    bool spawnWorkers(const std::string &executable, const std::string &socketPath, std::vector<int> &pids);
+
+public:
+    DistributedTrainer(const std::string &levelFile, int generations, int workers, int maxStepsPerGeneration = 0,
+                       const std::string &savePath = "");
+
+    // 0 keeps the SEED setting
+    void setSeed(unsigned int seed) { this->seed = seed; }
+
+    // Coordinator, starts the workers as child processes of executable
+    int run(const std::string &executable);
+
+    // Parses "--worker <socket> <index> <level> <steps> <threads>", started by the coordinator
+    static int runWorker(int argc, char *argv[]);
+};
+
+#endif //INTELLIDRIVE_DISTRIBUTEDTRAINER_H
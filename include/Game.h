@@ -32,6 +32,8 @@ public:
 
     void loadCarData(std::string path);
     void calculateAndDisplayFPS();
+    // FPS_COUNTER overlay, METRICS_MODE advanced adds the details of MetricsManager
+    void drawMetrics();
 
     Car& getCar() { return car; }
 
@@ -47,12 +49,11 @@ private:
     std::deque<float> frameTimes;
 
     sf::Font font;
-    sf::Text fpsText, lowsText, avgText;
+    sf::Text fpsText, lowsText, avgText, metricsText;
 
     const int maxFrameSamples = 300;
 
     void initializeText(sf::Text& text, float x, float y);
-    void parseCarDataLine(const std::string& line, carData& data);
     float calculateAverageFPS() const;
     float calculateOnePercentLowsFPS() const;
     void updateText(sf::Text& text, const std::string& label, float value);
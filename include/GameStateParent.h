@@ -20,6 +20,9 @@
 #include "DeathState.h"
 #include "Car.h"
 #include "Game.h"
+#include "TrackCollision.h"
+#include "TrackDistanceField.h"
+#include "TileLayer.h"
 
 #define M_PI 3.141592653589793238462643383279502884197169399375105820974944
 
@@ -35,13 +38,18 @@ private:
     std::vector<std::vector<sf::Sprite>> placedTileSprites;
     std::vector<Tile> tiles;
 
+    TrackCollision trackCollision;
+    TileLayer tileLayer;
+    TrackDistanceField distanceField;
+
     sf::Vector2f spawnPointPosition;
     sf::Vector2f spawnPointDirection;
     bool hasSpawnPoint = false;
     float debugTimer = 0.0f;
 
-    void loadLevelFromCSV(const std::string &filename, Game &game);
+    void loadLevelFromCSV(const std::string &filename);
     void loadBackground(Game &game);
+    void buildCollision();
 
 public:
     bool getLineIntersection(sf::Vector2f p0, sf::Vector2f p1,
@@ -53,14 +61,24 @@ public:
     bool isPointInPolygon(const sf::Vector2f& point, const sf::ConvexShape& polygon);
     bool isPointInPolygon(const sf::Vector2f& point, const sf::ConvexShape& polygon, const sf::Transform& transform);
 
+    // Both use the distance field of the level if it was built, the cached tile polygons otherwise
+    bool isPointOnTrack(const sf::Vector2f& point);
+    // Distance from origin along direction (normalized) until the ray leaves the road, at most maxDistance
+    float castRay(const sf::Vector2f& origin, const sf::Vector2f& direction, float maxDistance);
+
     bool isPauseKeyPressed(const sf::Event& event) const;
 
+    // Background and placed tiles with one draw call, baked on first use
+    void drawLevel(sf::RenderTarget& target) { tileLayer.draw(target, &backgroundSprite, placedTileSprites); }
+
     GameStateParent(Game& game, const std::string& levelFile);
+    explicit GameStateParent(const std::string& levelFile);
     explicit GameStateParent(Game& game) {};
 
     // Getter and Setter
     float &getDebugTimer() {return debugTimer;};
     sf::Vector2i &getBoundaries() {return boundaries;};
+    sf::Vector2f getLevelSize() const {return {boundaries.x * VariableManager::getTileSize(), boundaries.y * VariableManager::getTileSize()};};
     std::vector<std::vector<int>> &getPlacedTileIDs() {return this->placedTileIDs;};
     std::vector<std::vector<sf::Sprite>> &getPlacedTileSprites() {return this->placedTileSprites;};
     std::vector<Tile> &getTiles() {return this->tiles;};
@@ -0,0 +1,72 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef INTELLIDRIVE_HEADLESSTRAINER_H
+#define INTELLIDRIVE_HEADLESSTRAINER_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+
+#include "AiGameState.h"
+#include "ResourceManager.h"
+#include "VariableManager.h"
+#include "Mailbox.h"
+#include "RunManifest.h"
+
+// Runs the evolution of an AiGameState without a window as fast as the CPU allows
+class HeadlessTrainer {
+private:
+    std::string levelFile;
+    std::string savePath;
+    int generations;
+    int maxStepsPerGeneration;
+
+    // Island model, each island evolves its own population on its own thread
+    int islands = 1;
+    int migrationInterval = 5;
+    int migrants = 1;
+
+    using Genomes = std::vector<std::vector<float>>;
+
+    // Reproducibility, seed 0 keeps the SEED setting
+    unsigned int seed = 0;
+    std::string manifestPath;
+    RunManifest replay;
+    bool replaying = false;
+
+    std::vector<carData> cars;
+    std::mutex outputMutex;
+
+    // Simulates until the generation is over, returns the number of steps
+    int runGeneration(AiGameState &state, long long &carSteps);
+    void runIsland(int island, carData car, int networks, Mailbox<Genomes> &inbox, Mailbox<Genomes> &outbox,
+                   float &bestScore, std::vector<float> &bestGenome);
+    int runIslands(carData &car);
+public:
+    // Config, tiles and cars without any textures, shared with the distributed workers
+    static bool loadResources(std::vector<carData> &cars);
+
+    HeadlessTrainer(const std::string &levelFile, int generations, int maxStepsPerGeneration = 0,
+                    const std::string &savePath = "");
+
+    // Splits NETWORKS_AMOUNT across the islands, the best migrants move to the next island every interval generations
+    void setIslands(int islands, int migrationInterval, int migrants);
+    void setSeed(unsigned int seed) { this->seed = seed; }
+    // Writes the seed, settings and per generation fitness hashes of the run to path
+    void setManifestPath(const std::string &path) { manifestPath = path; }
+    // Runs with the settings and seed of the manifest and fails if any generation scores differently
+    void setReplay(const RunManifest &manifest) { replay = manifest; replaying = true; }
+
+    int run();
+
+    // Parses "--headless <level> [--generations N] [--steps N] [--save path]
+    //         [--islands N] [--migrate-every K] [--migrants M] [--workers N]
+    //         [--seed N] [--manifest path] [--replay manifest]"
+    static int runFromArguments(int argc, char *argv[]);
+};
+
+#endif //INTELLIDRIVE_HEADLESSTRAINER_H
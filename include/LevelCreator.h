@@ -11,6 +11,7 @@
 #include <string>
 #include "Tile.h"
 #include "GameState.h"
+#include "TileLayer.h"
 
 class Game;
 
@@ -90,6 +91,8 @@ private:
 
     std::vector<std::vector<int>> placedTileIDs;
     std::vector<std::vector<sf::Sprite>> placedTileSprites;
+    // Background and placed tiles, invalidated by every edit
+    TileLayer tileLayer;
 
     std::vector<Tile> tiles;
     int selectedTile = 0;
@@ -0,0 +1,35 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef INTELLIDRIVE_MAILBOX_H
+#define INTELLIDRIVE_MAILBOX_H
+
+#include <atomic>
+#include <memory>
+
+// Lock free single slot between threads. A new message replaces one that was not taken yet,
+// the receiver always gets the latest one.
+template<typename T>
+class Mailbox {
+private:
+    std::atomic<T *> slot{nullptr};
+
+public:
+    Mailbox() = default;
+    ~Mailbox() { delete slot.exchange(nullptr); }
+
+    Mailbox(const Mailbox &) = delete;
+    Mailbox &operator=(const Mailbox &) = delete;
+
+    void post(std::unique_ptr<T> message) {
+        delete slot.exchange(message.release(), std::memory_order_acq_rel);
+    }
+
+    // Empty if nothing arrived since the last call
+    std::unique_ptr<T> take() {
+        return std::unique_ptr<T>(slot.exchange(nullptr, std::memory_order_acq_rel));
+    }
+};
+
+#endif //INTELLIDRIVE_MAILBOX_H
@@ -6,23 +6,70 @@
 #define METRICSMANAGER_H
 
 #include <chrono>
+#include <string>
+#include <vector>
 
+// Resource use of the process. On Linux read from /proc/self and getrusage, elsewhere everything but
+// the frame times stays 0. The process numbers are sampled at most every sampleInterval seconds.
 class MetricsManager {
 public:
+    struct ThreadUsage {
+        int id = 0;
+        std::string name;
+        float cpu = 0.0f;               // Percent of one core
+        unsigned long long ticks = 0;   // User and system time in clock ticks, since the thread started
+    };
+
     static MetricsManager& getInstance();
     void frameStart();
+    // Also samples the process when the interval has passed
     void frameEnd();
+    void sample();
+
     float getFPS() const;
     float getFrameTime() const;
+    // Percent of one core used by the whole process since the previous sample
     float getCPUUsage() const;
+    // ArrayFire does not expose the utilisation, this is the device memory in use in MB
     float getGPUUsage() const;
+    // Resident set size in MB
     float getMemoryUsage() const;
 
+    long getMinorPageFaults() const { return minorFaults; }
+    long getMajorPageFaults() const { return majorFaults; }
+    long getVoluntaryContextSwitches() const { return voluntarySwitches; }
+    long getInvoluntaryContextSwitches() const { return involuntarySwitches; }
+    float getPeakMemoryUsage() const { return peakResidentMB; }
+    const std::vector<ThreadUsage>& getThreads() const { return threads; }
+    // Bytes the ArrayFire memory manager holds on the device, and the part of it in use
+    size_t getDeviceAllocatedBytes() const { return deviceAllocated; }
+    size_t getDeviceLockedBytes() const { return deviceLocked; }
+
+    // Lines for the overlay, advanced adds page faults, context switches, device memory and the busiest threads
+    std::string report(bool advanced) const;
+
 private:
     MetricsManager();
     std::chrono::high_resolution_clock::time_point lastFrame;
     float fps;
     float frameTime;
+
+    const float sampleInterval = 0.5f;
+    std::chrono::high_resolution_clock::time_point lastSample;
+    unsigned long long lastProcessTicks = 0;
+    // The usages need a previous sample
+    bool sampled = false;
+
+    float cpuUsage = 0.0f;
+    float residentMB = 0.0f;
+    float peakResidentMB = 0.0f;
+    long minorFaults = 0;
+    long majorFaults = 0;
+    long voluntarySwitches = 0;
+    long involuntarySwitches = 0;
+    std::vector<ThreadUsage> threads;
+    size_t deviceAllocated = 0;
+    size_t deviceLocked = 0;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,92 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef INTELLIDRIVE_POPULATION_H
+#define INTELLIDRIVE_POPULATION_H
+
+#include <vector>
+#include <cstdint>
+#include <SFML/Graphics.hpp>
+
+#include "Car.h"
+#include "VariableManager.h"
+
+// Structure of arrays holding the simulation state of all AI cars, index i is driven by network i.
+// The physics mirror Car::update, sprites are only set up for cars that are drawn.
+class Population {
+private:
+    int count = 0;
+    int rayCount = 0;
+
+    // Shared constants of the car template
+    float accelerationConstant = 0.0f;
+    float angularAccelerationConstant = 0.0f;
+    float maxSpeed = 0.0f;
+    float frictionCoefficient = 0.0f;
+    sf::Vector2f halfExtents;
+
+    // Pointers to the fields the physics integrate, either the arrays themselves or a gathered block
+    struct Lanes {
+        float *positionX, *positionY, *velocityX, *velocityY, *rotation, *angularVelocity;
+        float *acceleration, *angularAcceleration, *distanceRotated, *distanceMovedBackwards;
+        const std::uint8_t *alive;
+    };
+
+    Lanes lanes();
+    void integrate(const Lanes &lanes, int index, float dt) const;
+    void integrate(const Lanes &lanes, float dt, int begin, int end) const;
+
+public:
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> rotation;            // Degrees
+    std::vector<float> angularVelocity;
+    std::vector<float> acceleration;
+    std::vector<float> angularAcceleration;
+    std::vector<float> distanceRotated;
+    std::vector<float> distanceMovedBackwards;
+    std::vector<float> rayDistances;        // count * rayCount, rays of a car are contiguous
+    std::vector<sf::Vector2f> rayHits;      // Same layout, where each ray ended, only read for drawing
+    std::vector<int> nextCheckpoint;
+    std::vector<std::uint8_t> alive;
+    std::vector<float> points;
+    std::vector<float> timeSinceCheckpoint; // Simulated seconds
+    std::vector<int> checkpointsReached;
+    // Indices of the cars that still drive in ascending order, crashed and culled cars are compacted out
+    std::vector<int> activeCars;
+
+    Population() = default;
+
+    // Takes the physics constants and collision size from a car that already had applyData called
+    void initialize(int count, int rayCount, Car &templateCar);
+    void spawn(const sf::Vector2f &position, float rotationAngle);
+
+    void update(int index, float dt);
+    // Same physics as update for every alive car, vectorized with AVX2 or SSE2 when available
+    void updateBatch(float dt) { updateBatch(dt, 0, count); }
+    void updateBatch(float dt, int begin, int end);
+    // updateBatch for the cars activeCars[begin, end), gathered into blocks for the vector path
+    void updateActive(float dt, int begin, int end);
+    // Removes every car that is not alive anymore from activeCars
+    void compactActive();
+    void getCorners(int index, sf::Vector2f corners[4]) const;
+    void applyToSprite(int index, sf::Sprite &sprite) const;
+
+    [[nodiscard]] int size() const { return count; }
+    [[nodiscard]] int getActiveCount() const { return (int)activeCars.size(); }
+    [[nodiscard]] int getRayCount() const { return rayCount; }
+    [[nodiscard]] float getAccelerationConstant() const { return accelerationConstant; }
+    [[nodiscard]] float getAngularAccelerationConstant() const { return angularAccelerationConstant; }
+    [[nodiscard]] float *getRayDistances(int index) { return &rayDistances[static_cast<size_t>(index) * rayCount]; }
+    [[nodiscard]] sf::Vector2f *getRayHits(int index) { return &rayHits[static_cast<size_t>(index) * rayCount]; }
+
+    // Compares updateBatch against update on random states, prints the largest deviation
+    static bool verifyBatchUpdate(int count, int steps, float tolerance);
+    // "avx2", "sse2" or "scalar", the path this build uses for updateBatch
+    static const char *vectorPath();
+};
+
+#endif //INTELLIDRIVE_POPULATION_H
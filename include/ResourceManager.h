@@ -14,6 +14,7 @@
 #include <fstream>
 #include <sstream>
 #include "Tile.h"
+#include "TileAtlas.h"
 
 class ResourceManager {
 public:
@@ -26,19 +27,32 @@ public:
     static void setTexture(const std::string &name, const std::string &filename);
 
     [[ nodiscard ]] static sf::Texture& getTexture(const std::string& name);
+    [[ nodiscard ]] static sf::Vector2u getTextureSize(const std::string& name);
 
     [[ nodiscard ]] static std::vector<Tile> &getTiles() { return tiles; };
+    [[ nodiscard ]] static const TileAtlas &getTileAtlas() { return tileAtlas; };
 
     static void loadTilesFromCSV(const std::string& filename);
+    static void loadCarsFromCSV(const std::string& filename, std::vector<carData>& cars);
     static bool textureExists(const std::string& textureKey);
 
     static void setTile(int i, Tile &t) { tiles[i] = t; };
     [[ nodiscard ]] static Tile &getTile(int i) { return tiles[i]; };
 
+    // Headless mode never touches OpenGL, textures are replaced by their image dimensions
+    static void setHeadless(bool value) { headless = value; };
+    [[ nodiscard ]] static bool isHeadless() { return headless; };
+
 private:
+    static void parseCarDataLine(const std::string& line, carData& data);
+
+    static bool headless;
     static std::unordered_map<std::string, sf::Font> fonts;
     static std::unordered_map<std::string, sf::Texture> textures;
+    static std::unordered_map<std::string, sf::Vector2u> textureSizes;
     static std::vector<Tile> tiles;
+    // Owns the texture every tile refers to
+    static TileAtlas tileAtlas;
 };
 
 #endif // RESOURCEMANAGER_H
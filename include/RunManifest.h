@@ -0,0 +1,50 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef INTELLIDRIVE_RUNMANIFEST_H
+#define INTELLIDRIVE_RUNMANIFEST_H
+
+#include <string>
+#include <vector>
+
+#include "../vendors/json/json.hpp"
+
+// Everything needed to repeat a training run: seed, timestep, settings and the build,
+// plus a hash of the fitness of every generation to check that a repetition matched bit for bit.
+class RunManifest {
+private:
+    nlohmann::json data;
+
+public:
+    // Independent random streams derived from one seed
+    enum class Stream {
+        Initialization,
+        Breeding,
+        Selection
+    };
+
+    // SEED, or one seed drawn for the whole process when it is 0
+    static unsigned int runSeed();
+    // island keeps the streams of the islands apart
+    static unsigned long long deriveSeed(unsigned int seed, int island, Stream stream);
+    // FNV-1a over the bits of the scores
+    static std::string fitnessHash(const std::vector<float> &fitness);
+
+    // Captures the seed, the settings and the build at the start of a run
+    void begin(const std::string &levelFile, int generations, int maxSteps);
+    void addGeneration(int generation, const std::vector<float> &fitness, int steps);
+
+    bool save(const std::string &path) const;
+    bool load(const std::string &path);
+    // Restores the settings and the seed of a loaded manifest
+    void apply() const;
+    // First generation whose fitness differs from the other manifest, -1 when all of them match
+    int firstMismatch(const RunManifest &other) const;
+
+    [[nodiscard]] std::string getLevelFile() const { return data.value("level", std::string()); }
+    [[nodiscard]] int getGenerations() const { return data.value("generations", 0); }
+    [[nodiscard]] int getMaxSteps() const { return data.value("max_steps", 0); }
+};
+
+#endif //INTELLIDRIVE_RUNMANIFEST_H
@@ -0,0 +1,68 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef INTELLIDRIVE_THREADPOOL_H
+#define INTELLIDRIVE_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads, each with its own task deque. Workers take tasks from the back of
+// their own deque and steal from the front of the others when it runs empty.
+class ThreadPool {
+private:
+    struct Job {
+        const std::function<void(int, int)> *func = nullptr;
+        std::atomic<int> remaining{0};
+    };
+
+    struct Task {
+        int begin = 0;
+        int end = 0;
+        Job *job = nullptr;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    // One queue per worker plus the last one for the thread calling parallelFor
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+
+    std::atomic<int> queuedTasks{0};
+    std::atomic<bool> running{true};
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+
+    bool popTask(int queueIndex, Task &task);
+    bool stealTask(int queueIndex, Task &task);
+    bool runTask(int queueIndex);
+    void workerLoop(int queueIndex);
+
+public:
+    // 0 threads uses all hardware threads, 1 runs everything on the calling thread
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Threads working on a parallelFor, the calling thread included
+    [[nodiscard]] int getThreadCount() const { return (int)workers.size() + 1; }
+
+    // Calls func(rangeBegin, rangeEnd) on disjoint ranges of at most grainSize elements covering [begin, end)
+    // and returns once all of them are done. Which thread runs a range is not fixed, so func must only
+    // write to the elements of its range for the result to be independent of the thread count.
+    void parallelFor(int begin, int end, int grainSize, const std::function<void(int, int)> &func);
+};
+
+#endif //INTELLIDRIVE_THREADPOOL_H
@@ -11,19 +11,26 @@
     class Tile {
 
     private:
-        sf::Texture texture;
+        // Points into the tile atlas of the ResourceManager, textureRect is the part of this tile
+        const sf::Texture *texture = nullptr;
+        sf::IntRect textureRect;
+        sf::Vector2u size;
         std::string texturePath;
         std::vector<sf::Vector2f> collisionPolygon;
 
     public:
         Tile() = default;
-        explicit Tile(std::string path);
+        Tile(std::string path, const sf::Texture &atlas, const sf::IntRect &rect);
         ~Tile() = default;
 
         sf::ConvexShape collisionShape;
         void initializeCollisionShape();
 
-        [[nodiscard]] sf::Texture& getTexture() { return texture; }
+        [[nodiscard]] const sf::Texture& getTexture() const;
+        [[nodiscard]] const sf::IntRect& getTextureRect() const { return textureRect; }
+        // Sets the atlas texture and the rect of this tile
+        void applyTo(sf::Sprite& sprite) const;
+        [[nodiscard]] const sf::Vector2u& getSize() const { return size; }
         [[nodiscard]] const std::vector<sf::Vector2f>& getCollisionPolygon() const { return collisionPolygon; }
         [[nodiscard]] const std::string& getTexturePath() const { return texturePath; }
 
@@ -0,0 +1,42 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef INTELLIDRIVE_TILEATLAS_H
+#define INTELLIDRIVE_TILEATLAS_H
+
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+// All tile images packed into one texture, tiles reference their part of it by rect.
+// The packed image can be cached on disk next to a list of the sources it was built from.
+class TileAtlas {
+private:
+    // Every image gets a border of copied edge pixels, so filtering never samples a neighbour
+    static constexpr int border = 1;
+
+    sf::Image image;
+    sf::Texture texture;
+    std::vector<sf::IntRect> rects;
+
+    // Size and modification time of a source file, empty if it does not exist
+    static std::string stamp(const std::string &path);
+
+public:
+    TileAtlas() = default;
+
+    bool pack(const std::vector<sf::Image> &images);
+    // Uploads the packed image, needs an OpenGL context
+    bool createTexture();
+
+    // The cache consists of path.png and path.csv, it is only used if every source is unchanged
+    bool loadCache(const std::string &path, const std::vector<std::string> &sources);
+    bool saveCache(const std::string &path, const std::vector<std::string> &sources) const;
+
+    [[nodiscard]] const sf::Texture &getTexture() const { return texture; }
+    [[nodiscard]] const sf::IntRect &getRect(int i) const { return rects[i]; }
+    [[nodiscard]] size_t size() const { return rects.size(); }
+};
+
+#endif //INTELLIDRIVE_TILEATLAS_H
@@ -0,0 +1,35 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef INTELLIDRIVE_TILELAYER_H
+#define INTELLIDRIVE_TILELAYER_H
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+// The static part of a level, the background and all placed tiles, baked into one texture.
+// Drawing it is a single call, it is only baked again after invalidate or when the target size changes.
+class TileLayer {
+private:
+    sf::RenderTexture texture;
+    sf::Sprite sprite;
+    bool dirty = true;
+
+    // The four corners of a sprite with the texture coordinates of its rect
+    static void appendQuad(sf::VertexArray &quads, const sf::Sprite &tile);
+    void bake(const sf::Vector2u &size, const sf::Sprite *background,
+              const std::vector<std::vector<sf::Sprite>> &placedTileSprites);
+
+public:
+    TileLayer() = default;
+
+    // Has to be called whenever a tile is placed or removed
+    void invalidate() { dirty = true; }
+
+    // background may be null, then the layer is transparent outside of the tiles
+    void draw(sf::RenderTarget &target, const sf::Sprite *background,
+              const std::vector<std::vector<sf::Sprite>> &placedTileSprites);
+};
+
+#endif //INTELLIDRIVE_TILELAYER_H
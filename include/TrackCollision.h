@@ -0,0 +1,55 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef INTELLIDRIVE_TRACKCOLLISION_H
+#define INTELLIDRIVE_TRACKCOLLISION_H
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "Tile.h"
+
+// World-space collision polygons of all placed tiles, built once per level so that the hot loops
+// never have to transform a tile polygon again
+class TrackCollision {
+private:
+    struct Edge {
+        float x0, y0;     // Start point
+        float dx, dy;     // End point - start point
+        float slopeX;     // dx / dy, used by the crossing test
+    };
+
+    struct Cell {
+        int firstEdge = 0;
+        int edgeCount = 0; // 0 for cells without a tile
+        float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    };
+
+    int width = 0;
+    int height = 0;
+    float tileSize = 1.0f;
+
+    std::vector<Cell> cells;
+    std::vector<Edge> edges;
+
+    [[nodiscard]] bool isPointInCell(const Cell &cell, float x, float y) const;
+
+public:
+    TrackCollision() = default;
+
+    void build(const sf::Vector2i &boundaries, float tileSize,
+               const std::vector<std::vector<int>> &placedTileIDs,
+               const std::vector<std::vector<sf::Sprite>> &placedTileSprites,
+               const std::vector<Tile> &tiles);
+    void clear();
+
+    [[nodiscard]] bool isEmpty() const { return cells.empty(); }
+
+    // Checks the polygons of the tile under the point and its 8 neighbours
+    [[nodiscard]] bool isPointOnTrack(const sf::Vector2f &point) const;
+    // Grid traversal (Amanatides-Woo) with an exact intersection against the polygon edges of each visited cell
+    [[nodiscard]] float castRay(const sf::Vector2f &origin, const sf::Vector2f &direction, float maxDistance) const;
+};
+
+#endif //INTELLIDRIVE_TRACKCOLLISION_H
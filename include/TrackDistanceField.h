@@ -0,0 +1,43 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef INTELLIDRIVE_TRACKDISTANCEFIELD_H
+#define INTELLIDRIVE_TRACKDISTANCEFIELD_H
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <SFML/Graphics.hpp>
+
+// Rasterized track of a level: an occupancy bitmap plus a signed distance field (positive on the road)
+class TrackDistanceField {
+private:
+    int width = 0;
+    int height = 0;
+    float texelSize = 1.0f;
+
+    std::vector<std::uint64_t> occupancy;
+    std::vector<float> distances;
+
+    static void distanceTransform(std::vector<float> &grid, int width, int height);
+
+public:
+    TrackDistanceField() = default;
+
+    // Samples isOnTrack at every texel center of the level and computes the distance field from it
+    void build(const sf::Vector2f &levelSize, float texelSize, const std::function<bool(const sf::Vector2f &)> &isOnTrack);
+    void clear();
+
+    [[nodiscard]] bool isEmpty() const { return distances.empty(); }
+    [[nodiscard]] float getTexelSize() const { return texelSize; }
+
+    // Single bitmap lookup
+    [[nodiscard]] bool isOnTrack(const sf::Vector2f &point) const;
+    // Bilinear signed distance in pixels, negative off the road
+    [[nodiscard]] float distance(const sf::Vector2f &point) const;
+    // Sphere tracing along a normalized direction until the road ends
+    [[nodiscard]] float castRay(const sf::Vector2f &origin, const sf::Vector2f &direction, float maxDistance) const;
+};
+
+#endif //INTELLIDRIVE_TRACKDISTANCEFIELD_H
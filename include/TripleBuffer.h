@@ -0,0 +1,46 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef INTELLIDRIVE_TRIPLEBUFFER_H
+#define INTELLIDRIVE_TRIPLEBUFFER_H
+
+#include <atomic>
+
+// Hands the latest value from one writer thread to one reader thread without locking.
+// The writer fills its back buffer and swaps it with the middle one, the reader swaps the middle one
+// with its front buffer when something new arrived. Neither side ever waits, values in between are dropped.
+template <typename T>
+class TripleBuffer {
+private:
+    static constexpr int freshBit = 4;
+    static constexpr int indexMask = 3;
+
+    T buffers[3];
+    int back = 0;
+    int front = 1;
+    // Index of the middle buffer, freshBit is set while the reader has not taken it
+    std::atomic<int> middle{2};
+
+public:
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    // Writer side, fill it and then publish
+    T &write() { return buffers[back]; }
+    void publish() { back = middle.exchange(back | freshBit) & indexMask; }
+    // True until the reader took the last published value
+    [[nodiscard]] bool isPending() const { return middle.load() & freshBit; }
+
+    // Reader side, the newest published value, or the previous one if nothing new arrived
+    const T &read() {
+        if (middle.load() & freshBit) {
+            front = middle.exchange(front) & indexMask;
+        }
+        return buffers[front];
+    }
+};
+
+#endif //INTELLIDRIVE_TRIPLEBUFFER_H
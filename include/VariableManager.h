@@ -27,6 +27,7 @@ private:
     static float MAX_SPEED; // Units: pixels per second
     static float ROTATIONAL_SPEED_MULTIPLIER;
     static float ANGULAR_DAMPING_MULTIPLIER;
+    static float SIMULATION_TIMESTEP; // Units: seconds per AI simulation step
 
     // Car
     static int SELECTED_CAR_INDEX;
@@ -34,6 +35,15 @@ private:
 
     // World
     static float TILE_SIZE;
+    static bool USE_DISTANCE_FIELD;
+    static float DISTANCE_FIELD_TEXEL_SIZE;
+
+    // Performance
+    static int THREADS;
+    static bool ADAPTIVE_SIMULATION_SPEED;
+    static float TARGET_FRAME_TIME; // Units: milliseconds
+    static int MAX_STEPS_PER_FRAME;
+    static bool THREADED_SIMULATION;
 
     // Resources
     static std::string FONT_RUBIK_REGULAR;
@@ -42,9 +52,11 @@ private:
 
     static std::string PATH_TO_CONFIG;
     static std::string PATH_TO_TILE_CONFIG;
+    static std::string TILE_ATLAS_CACHE;
     static std::string PATH_TO_CAR_CONFIG;
     static std::string PATH_TO_LEVELS;
     static std::string PATH_TO_BACKGROUNDS;
+    static std::string PATH_TO_CHECKPOINTS;
 
     static std::string IMAGE_CAR_CHOOSING_ARROW_LEFT;
     static std::string IMAGE_CAR_CHOOSING_ARROW_RIGHT;
@@ -55,6 +67,7 @@ private:
     static int RAY_AMOUNT;
     static float AI_FOV;
     static int NETWORKS_AMOUNT;
+    static bool USE_CPU_INFERENCE;
     static std::vector<int> AI_TOPOLOGY;
     static float AI_INITIAL_RANDOM_VALUES_MAX;
     static bool AI_INITIAL_RANDOM_VALUES_UNIFORM;
@@ -68,12 +81,23 @@ private:
     static float BACKWARDS_MOVEMENT_PENALTY;
     static float RESTART_ON_DEAD_PERCENTAGE;
     static float MUTATION_INDEX;
+    static std::string SELECTION_STRATEGY;
+    static int TOURNAMENT_SIZE;
+    static float RANK_PRESSURE;
+    static float STAGNATION_TIMEOUT; // Units: simulated seconds, 0 disables
+    static float MAX_GENERATION_TIME; // Units: simulated seconds, 0 disables
+    static float MIN_PROGRESS_RATE; // Units: checkpoints per simulated second, 0 disables
+    static unsigned int SEED; // 0 draws a new seed for every run
 
     // DEBUG - RENDER
     static bool SHOW_COLLIDERS;
     static bool SHOW_CHECKPOINTS;
     static bool SHOW_RAYS;
     static bool SHOW_CARS_FIRST;
+    static std::string RENDER_POLICY;
+    static int RENDER_CAR_LIMIT;
+    static int POINT_SPRITE_THRESHOLD;
+    static int POINT_SPRITE_LEADERS;
 
     // Game
     static bool AI_MODE;
@@ -91,6 +115,9 @@ public:
     /// Load and Save functions
     static void VariableManager::loadFromJson(const std::string& filePath);
     static void VariableManager::saveToJson(const std::string& filePath);
+    // All settings as they are saved, used by the run manifest
+    static nlohmann::json toJson();
+    static void fromJson(const nlohmann::json& jsonData);
 
     /// Getter and Setter functions
 
@@ -113,6 +140,9 @@ public:
     static float getAngularDampingMultiplier() { return ANGULAR_DAMPING_MULTIPLIER; }
     static void setAngularDampingMultiplier(float value) { ANGULAR_DAMPING_MULTIPLIER = value; }
 
+    static float getSimulationTimestep() { return SIMULATION_TIMESTEP; }
+    static void setSimulationTimestep(float value) { SIMULATION_TIMESTEP = value; }
+
     // Car
     static int getSelectedCarIndex() { return SELECTED_CAR_INDEX; }
     static void setSelectedCarIndex(int value) { SELECTED_CAR_INDEX = value; }
@@ -121,6 +151,28 @@ public:
     static float getTileSize() { return TILE_SIZE; }
     static void setTileSize(float value) { TILE_SIZE = value; }
 
+    static bool getUseDistanceField() { return USE_DISTANCE_FIELD; }
+    static void setUseDistanceField(bool value) { USE_DISTANCE_FIELD = value; }
+
+    static float getDistanceFieldTexelSize() { return DISTANCE_FIELD_TEXEL_SIZE; }
+    static void setDistanceFieldTexelSize(float value) { DISTANCE_FIELD_TEXEL_SIZE = value; }
+
+    // Performance
+    static int getThreads() { return THREADS; }
+    static void setThreads(int value) { THREADS = value; }
+
+    static bool getAdaptiveSimulationSpeed() { return ADAPTIVE_SIMULATION_SPEED; }
+    static void setAdaptiveSimulationSpeed(bool value) { ADAPTIVE_SIMULATION_SPEED = value; }
+
+    static float getTargetFrameTime() { return TARGET_FRAME_TIME; }
+    static void setTargetFrameTime(float value) { TARGET_FRAME_TIME = value; }
+
+    static int getMaxStepsPerFrame() { return MAX_STEPS_PER_FRAME; }
+    static void setMaxStepsPerFrame(int value) { MAX_STEPS_PER_FRAME = value; }
+
+    static bool getThreadedSimulation() { return THREADED_SIMULATION; }
+    static void setThreadedSimulation(bool value) { THREADED_SIMULATION = value; }
+
     // Resources
     static std::string getFontRubikRegular() { return FONT_RUBIK_REGULAR; }
     static void setFontRubikRegular(const std::string& value) { FONT_RUBIK_REGULAR = value; }
@@ -137,6 +189,9 @@ public:
     static std::string getPathToTileConfig() { return PATH_TO_TILE_CONFIG; }
     static void setPathToTileConfig(const std::string& value) { PATH_TO_TILE_CONFIG = value; }
 
+    static std::string getTileAtlasCache() { return TILE_ATLAS_CACHE; }
+    static void setTileAtlasCache(const std::string& value) { TILE_ATLAS_CACHE = value; }
+
     static std::string getPathToCarConfig() { return PATH_TO_CAR_CONFIG; }
     static void setPathToCarConfig(const std::string& value) { PATH_TO_CAR_CONFIG = value; }
 
@@ -146,6 +201,9 @@ public:
     static std::string getPathToBackgrounds() { return PATH_TO_BACKGROUNDS; }
     static void setPathToBackgrounds(const std::string& value) { PATH_TO_BACKGROUNDS = value; }
 
+    static std::string getPathToCheckpoints() { return PATH_TO_CHECKPOINTS; }
+    static void setPathToCheckpoints(const std::string& value) { PATH_TO_CHECKPOINTS = value; }
+
     static std::string getImageCarChoosingArrowLeft() { return IMAGE_CAR_CHOOSING_ARROW_LEFT; }
     static void setImageCarChoosingArrowLeft(const std::string& value) { IMAGE_CAR_CHOOSING_ARROW_LEFT = value; }
 
@@ -168,6 +226,9 @@ public:
     static int getNetworksAmount() { return NETWORKS_AMOUNT; }
     static void setNetworksAmount(int value) { NETWORKS_AMOUNT = value; }
 
+    static bool getUseCpuInference() { return USE_CPU_INFERENCE; }
+    static void setUseCpuInference(bool value) { USE_CPU_INFERENCE = value; }
+
     static std::vector<int> &getAiTopology() { return AI_TOPOLOGY; }
     static void setAiTopology(std::vector<int> &value) { AI_TOPOLOGY = value; }
 
@@ -202,6 +263,27 @@ public:
     static float getMutationIndex() { return MUTATION_INDEX; }
     static void setMutationIndex(float value) { MUTATION_INDEX = value; }
 
+    static std::string getSelectionStrategy() { return SELECTION_STRATEGY; }
+    static void setSelectionStrategy(const std::string& value) { SELECTION_STRATEGY = value; }
+
+    static int getTournamentSize() { return TOURNAMENT_SIZE; }
+    static void setTournamentSize(int value) { TOURNAMENT_SIZE = value; }
+
+    static float getRankPressure() { return RANK_PRESSURE; }
+    static void setRankPressure(float value) { RANK_PRESSURE = value; }
+
+    static float getStagnationTimeout() { return STAGNATION_TIMEOUT; }
+    static void setStagnationTimeout(float value) { STAGNATION_TIMEOUT = value; }
+
+    static float getMaxGenerationTime() { return MAX_GENERATION_TIME; }
+    static void setMaxGenerationTime(float value) { MAX_GENERATION_TIME = value; }
+
+    static float getMinProgressRate() { return MIN_PROGRESS_RATE; }
+    static void setMinProgressRate(float value) { MIN_PROGRESS_RATE = value; }
+
+    static unsigned int getSeed() { return SEED; }
+    static void setSeed(unsigned int value) { SEED = value; }
+
     // DEBUG - RENDER
     static bool getShowColliders() { return SHOW_COLLIDERS; }
     static void setShowColliders(bool value) { SHOW_COLLIDERS = value; }
@@ -215,6 +297,18 @@ public:
     static bool getShowCarsFirst() { return SHOW_CARS_FIRST; }
     static void setShowCarsFirst(bool value) { SHOW_CARS_FIRST = value; }
 
+    static std::string getRenderPolicy() { return RENDER_POLICY; }
+    static void setRenderPolicy(const std::string& value) { RENDER_POLICY = value; }
+
+    static int getRenderCarLimit() { return RENDER_CAR_LIMIT; }
+    static void setRenderCarLimit(int value) { RENDER_CAR_LIMIT = value; }
+
+    static int getPointSpriteThreshold() { return POINT_SPRITE_THRESHOLD; }
+    static void setPointSpriteThreshold(int value) { POINT_SPRITE_THRESHOLD = value; }
+
+    static int getPointSpriteLeaders() { return POINT_SPRITE_LEADERS; }
+    static void setPointSpriteLeaders(int value) { POINT_SPRITE_LEADERS = value; }
+
     // Game
     static bool getAiMode() { return AI_MODE; };
     static void setAiMode(bool v) { AI_MODE = v; };
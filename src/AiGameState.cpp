@@ -3,230 +3,193 @@
 //
 
 # include "AiGameState.h"
-
-AiGameState::AiGameState(Game &game, const std::string &levelFile) : GameStateParent(game, levelFile) {
+#include "RunManifest.h"
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+AiGameState::AiGameState(Game &game, const std::string &levelFile)
+        : GameStateParent(game, levelFile), threadPool(VariableManager::getThreads()) {
     carTemplate = game.cars[VariableManager::getSelectedCarIndex()];
 
-    for (int i = 0; i < VariableManager::getAiTopology().size(); ++i) {
-        std::cout << i << ": " << VariableManager::getAiTopology()[i] << "\n";
-    }
-
-    network = NeuralNetwork(VariableManager::getAiTopology(),
-                            VariableManager::getAiActivations(),
-                            -VariableManager::getAiInitialRandomValuesMax(),
-                            +VariableManager::getAiInitialRandomValuesMax(),
-                            VariableManager::getAiInitialRandomValuesUniform(),
-                            VariableManager::getNetworksAmount());
-
+    this->initializeNetwork();
     this->initializeRayAngles();
     this->initializeCar();
-    this->initializeRays();
+    this->loadCheckpoints(levelFile);
 
     // Load Font
     textFont = ResourceManager::getFont("Rubik-Regular");
-}
-
-void AiGameState::initializeCar() {
-    bool hasSpawnPoint = this->getHasSpawnpoint();
-    std::cout << "[DEBUG] Initializing cars\n";
 
-    auto &spawnPointPosition = this->getSpawnPointPosition();
-    auto &spawnPointDirection = this->getSpawnPointDirection();
-    players.clear();
-    for (int playerIDX = 0; playerIDX < VariableManager::getNetworksAmount(); ++playerIDX) {
-        Player player;
-        
-        player.car = {};
-        player.car.applyData(carTemplate);
-        Car &car = player.car;
-
-        sf::Sprite &carSprite = car.getCarSprite();
-        carSprite.setOrigin(carSprite.getLocalBounds().width / 2, carSprite.getLocalBounds().height / 2);
-
-        if (hasSpawnPoint) {
-            carSprite.setPosition(spawnPointPosition);
-            car.resetVelocity();
-            car.resetAngularAcceleration();
-
-            float angle = std::atan2(spawnPointDirection.y, spawnPointDirection.x) * 180.f / M_PI + 90.f;
-            car.setRotationAngle(angle);
-
-            car.setPreviousPosition(spawnPointPosition);
-            car.setCurrentPosition(spawnPointPosition);
-        } else {
-            carSprite.setPosition(400, 400);
-            car.resetVelocity();
-            car.resetAngularAcceleration();
-            car.resetRotationAngle();
-            car.setPreviousPosition({carSprite.getPosition().x, carSprite.getPosition().y});
-            car.setCurrentPosition({carSprite.getPosition().x, carSprite.getPosition().y});
-        }
-
-        players.emplace_back(player);
+    publishSnapshot();
+    if (VariableManager::getThreadedSimulation()) {
+        simulationRunning = true;
+        simulationThread = std::thread(&AiGameState::simulationLoop, this);
     }
 }
 
-void AiGameState::initializeRays() {
-    int raySize = rayAngles.size();
+AiGameState::~AiGameState() {
+    stopSimulation();
+}
 
-    for (int playerIDX = 0; playerIDX < players.size(); ++playerIDX) {
-        Player &player = players[playerIDX];
-        player.rayDistances = std::vector<float>(raySize, 0.0f);
-        player.rays = std::vector<sf::VertexArray>(raySize, {});
-        player.collisionMarkers = std::vector<sf::CircleShape>(raySize, {});
+AiGameState::AiGameState(const std::string &levelFile, carData &carTemplate, int networks, int threads, int island)
+        : GameStateParent(levelFile), threadPool(threads >= 0 ? threads : VariableManager::getThreads()), island(island) {
+    this->carTemplate = carTemplate;
+    if (networks > 0) {
+        networkCount = networks;
     }
+
+    this->initializeNetwork();
+    this->initializeRayAngles();
+    this->initializeCar();
+    this->loadCheckpoints(levelFile);
 }
 
-void AiGameState::performRaycasts(Game &game) {
-    sf::Vector2i &boundaries = this->getBoundaries();
-    auto &placedTileIDs = this->getPlacedTileIDs();
-    auto &placedTileSprites = this->getPlacedTileSprites();
-    auto &tiles = this->getTiles();
+void AiGameState::initializeNetwork() {
+    for (int i = 0; i < VariableManager::getAiTopology().size(); ++i) {
+        std::cout << i << ": " << VariableManager::getAiTopology()[i] << "\n";
+    }
 
-    for (int playerIDX = 0; playerIDX < VariableManager::getNetworksAmount(); ++playerIDX) {
-        Player &player = players[playerIDX];
-        Car &car = player.car;
-        auto &collisionMarkers = player.collisionMarkers;
-        auto &rays = player.rays;
-        auto &rayDistances = player.rayDistances;
+    // Initialization, crossover and mutation and the selection each use their own seeded stream
+    unsigned int seed = RunManifest::runSeed();
+    network = NeuralNetwork(VariableManager::getAiTopology(), VariableManager::getAiActivations(), networkCount);
+    network.seed(RunManifest::deriveSeed(seed, island, RunManifest::Stream::Initialization));
+    network.randomize(-VariableManager::getAiInitialRandomValuesMax(),
+                      +VariableManager::getAiInitialRandomValuesMax(),
+                      VariableManager::getAiInitialRandomValuesUniform());
+    network.seed(RunManifest::deriveSeed(seed, island, RunManifest::Stream::Breeding));
+
+    if (VariableManager::getSelectionStrategy() == "truncation") {
+        selection.reset();
+    } else {
+        selection = SelectionStrategy::create(VariableManager::getSelectionStrategy(), VariableManager::getTournamentSize(),
+                                              VariableManager::getRankPressure());
+        selection->seed((unsigned int)RunManifest::deriveSeed(seed, island, RunManifest::Stream::Selection));
+    }
+}
 
-        float rotation_angle = car.getRotationAngle();
-        sf::Vector2f carPosition = car.getCurrentPosition();
+void AiGameState::loadCheckpoints(const std::string &levelFile) {
+    // Checkpoints are stored per level name, one "x,y" pair per line
+    std::string levelName = std::filesystem::path(levelFile).stem().string();
+    checkpointFile = VariableManager::getPathToCheckpoints() + levelName + ".csv";
 
-        std::vector<float> transformedAngles(rayAngles.size(), 0.0f);
+    std::ifstream file(checkpointFile);
+    if (!file.is_open()) {
+        std::cout << "[DEBUG] No checkpoints found for level: " << levelName << "\n";
+        return;
+    }
 
-        // Normalize angles between 0 and 360 degrees
-        for (int i = 0; i <= rayAngles.size(); i++) {
-            float angle = rayAngles[i];
-            transformedAngles[i] = fmod(angle + rotation_angle + 360.0f, 360.0f);
+    checkpoints.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        std::stringstream ss(line);
+        std::string xStr, yStr;
+        if (std::getline(ss, xStr, ',') && std::getline(ss, yStr)) {
+            checkpoints.emplace_back(std::stof(xStr), std::stof(yStr));
         }
+    }
+    std::cout << "[DEBUG] Loaded " << checkpoints.size() << " checkpoints from " << checkpointFile << "\n";
+}
 
-        collisionMarkers.clear();
-        rays.clear();
-
-        sf::Vector2u windowSize = game.window.getSize();
-        int tileSize = VariableManager::getTileSize();
-
-        for (size_t i = 0; i < transformedAngles.size(); ++i) {
-            float angle = transformedAngles[i];
-            float radian_angle = angle * (M_PI / 180.0f);
-            sf::Vector2f direction(std::sin(radian_angle), -std::cos(radian_angle));
-
-            sf::Vector2f rayStart = carPosition;
-            sf::Vector2f rayEnd = carPosition;
+void AiGameState::saveCheckpoints() {
+    std::filesystem::create_directories(VariableManager::getPathToCheckpoints());
 
-            float stepSize = 5.0f; // Adjust step size for accuracy and performance
+    std::ofstream file(checkpointFile);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file for writing: " << checkpointFile << "\n";
+        return;
+    }
+    for (const auto &checkpoint : checkpoints) {
+        file << checkpoint.x << "," << checkpoint.y << "\n";
+    }
+    std::cout << "[DEBUG] Saved " << checkpoints.size() << " checkpoints to " << checkpointFile << "\n";
+}
 
-            bool rayTerminated = false;
-            while (!rayTerminated) {
-                rayEnd += direction * stepSize;
+void AiGameState::initializeCar() {
+    bool hasSpawnPoint = this->getHasSpawnpoint();
+    std::cout << "[DEBUG] Initializing cars\n";
 
-                // Check if rayEnd is outside window bounds
-                if (rayEnd.x < 0 || rayEnd.x >= windowSize.x || rayEnd.y < 0 || rayEnd.y >= windowSize.y) {
-                    rayTerminated = true;
-                    break;
-                }
+    auto &spawnPointPosition = this->getSpawnPointPosition();
+    auto &spawnPointDirection = this->getSpawnPointDirection();
 
-                // Determine which tile the rayEnd is over
-                int tileX = static_cast<int>(rayEnd.x / tileSize);
-                int tileY = static_cast<int>(rayEnd.y / tileSize);
+    // One template car provides the constants and the sprite used to draw every car
+    Car car;
+    car.applyData(carTemplate);
+    sf::Vector2f origin(car.getCarSprite().getLocalBounds().width / 2, car.getCarSprite().getLocalBounds().height / 2);
+    car.getCarSprite().setOrigin(origin);
+    // Set once, later generations may start on the simulation thread while the sprite is drawn
+    if (!carSprite.getTexture()) {
+        carSprite = car.getCarSprite();
+    }
 
-                // Check if tileX and tileY are within boundaries
-                if (tileX < 0 || tileX >= boundaries.x || tileY < 0 || tileY >= boundaries.y) {
-                    rayTerminated = true;
-                    break;
-                }
+    population.initialize(networkCount, (int)rayAngles.size(), car);
 
-                int tileID = placedTileIDs[tileX][tileY];
+    if (hasSpawnPoint) {
+        float angle = std::atan2(spawnPointDirection.y, spawnPointDirection.x) * 180.f / M_PI + 90.f;
+        population.spawn(spawnPointPosition, angle);
+    } else {
+        population.spawn({400, 400}, 0.0f);
+    }
+}
 
-                // If there is no tile at this position, terminate the ray
-                if (tileID == -1) {
-                    rayTerminated = true;
-                    break;
-                }
+void AiGameState::performRaycasts() {
+    // Only the cars that still drive need rays
+    threadPool.parallelFor(0, population.getActiveCount(), 64, [this](int begin, int end) {
+        performRaycasts(begin, end);
+    });
+}
 
-                // Get the tile and its collision shape
-                Tile& tile = tiles[tileID];
-                const sf::ConvexShape& collisionShape = tile.collisionShape;
-                sf::Sprite& tileSprite = placedTileSprites[tileX][tileY];
+void AiGameState::performRaycasts(int begin, int end) {
+    int raySize = rayAngles.size();
 
-                // Apply the tile sprite's transform to the collision shape
-                sf::Transform combinedTransform = tileSprite.getTransform();
+    for (int activeIDX = begin; activeIDX < end; ++activeIDX) {
+        int playerIDX = population.activeCars[activeIDX];
+        float *rayDistances = population.getRayDistances(playerIDX);
+        sf::Vector2f *rayHits = population.getRayHits(playerIDX);
 
-                // Check if the point is within the collision shape of the tile
-                if (!isPointInPolygon(rayEnd, collisionShape, combinedTransform)) {
-                    // The point is in a transparent area (e.g., outside the road), terminate the ray
-                    rayTerminated = true;
-                    break;
-                }
+        float rotation_angle = population.rotation[playerIDX];
+        sf::Vector2f carPosition(population.positionX[playerIDX], population.positionY[playerIDX]);
 
-                // Optional: To prevent the ray from getting stuck due to minimal movement, add a maximum length
-                float distance = sqrtf(
-                        (rayEnd.x - carPosition.x) * (rayEnd.x - carPosition.x) +
-                        (rayEnd.y - carPosition.y) * (rayEnd.y - carPosition.y)
-                );
-                if (distance >= 10000.0f) { // Adjust maximum length as needed
-                    rayTerminated = true;
-                    break;
-                }
-            }
+        for (int i = 0; i < raySize; ++i) {
+            // Normalize angles between 0 and 360 degrees
+            float angle = fmod(rayAngles[i] + rotation_angle + 360.0f, 360.0f);
+            float radian_angle = angle * (M_PI / 180.0f);
+            sf::Vector2f direction(std::sin(radian_angle), -std::cos(radian_angle));
 
-            float distance = sqrtf(
-                    (rayEnd.x - carPosition.x) * (rayEnd.x - carPosition.x) +
-                    (rayEnd.y - carPosition.y) * (rayEnd.y - carPosition.y)
-            );
+            float distance = castRay(carPosition, direction, 10000.0f);
             rayDistances[i] = distance;
-
-            // Create the ray visual representation
-            if (VariableManager::getShowRays()) {
-                sf::VertexArray ray(sf::Lines, 2);
-                ray[0].position = carPosition;
-                ray[0].color = sf::Color(0, 255, 255, 255);
-                ray[1].position = rayEnd;
-                ray[1].color = sf::Color(0, 255, 255, 255);
-                rays.push_back(ray);
-
-                // Add a marker at the collision point
-                collisionMarkers.emplace_back();
-                sf::CircleShape& marker = collisionMarkers.back();
-                marker.setRadius(5);
-                marker.setPosition(rayEnd - sf::Vector2f(5, 5));
-                marker.setFillColor(sf::Color::Red);
-            }
+            // Always written, the rays are only built from it when they are drawn
+            rayHits[i] = carPosition + direction * distance;
         }
     }
 }
 
 void AiGameState::render(Game &game) {
-    sf::Vector2i &boundaries = this->getBoundaries();
-    auto &backgroundSprite = this->getBackgroundSprite();
-    auto &placedTileIDs = this->getPlacedTileIDs();
-    auto &placedTileSprites = this->getPlacedTileSprites();
-    auto &tiles = this->getTiles();
+    auto renderStart = std::chrono::high_resolution_clock::now();
 
     game.window.clear();
-    game.window.draw(backgroundSprite);
-
-    for (int x = 0; x < boundaries.x; ++x) {
-        for (int y = 0; y < boundaries.y; ++y) {
-            game.window.draw(placedTileSprites[x][y]);
-
-            int tileID = placedTileIDs[x][y];
-            if (tileID >= 0) {
-                Tile &tile = tiles[tileID];
-                sf::ConvexShape collisionShape = tile.collisionShape;
-
-                // Set visual properties for debugging
-                if (VariableManager::getShowColliders())
-                {
-                    collisionShape.setFillColor(sf::Color(255, 0, 0, 100)); // Semi-transparent red
-                    collisionShape.setOutlineColor(sf::Color::Red);
-                    collisionShape.setOutlineThickness(1.0f);
-
-                    // Apply the tile's transform
-                    sf::Transform transform = placedTileSprites[x][y].getTransform();
-                    game.window.draw(collisionShape, transform);
-                }
+    drawLevel(game.window);
+
+    // Collision shapes are debug only, nothing is copied per tile unless they are shown
+    if (VariableManager::getShowColliders()) {
+        sf::Vector2i &boundaries = this->getBoundaries();
+        auto &placedTileIDs = this->getPlacedTileIDs();
+        auto &placedTileSprites = this->getPlacedTileSprites();
+        auto &tiles = this->getTiles();
+
+        for (int x = 0; x < boundaries.x; ++x) {
+            for (int y = 0; y < boundaries.y; ++y) {
+                int tileID = placedTileIDs[x][y];
+                if (tileID < 0) continue;
+
+                sf::ConvexShape collisionShape = tiles[tileID].collisionShape;
+                collisionShape.setFillColor(sf::Color(255, 0, 0, 100)); // Semi-transparent red
+                collisionShape.setOutlineColor(sf::Color::Red);
+                collisionShape.setOutlineThickness(1.0f);
+
+                // Apply the tile's transform
+                sf::Transform transform = placedTileSprites[x][y].getTransform();
+                game.window.draw(collisionShape, transform);
             }
         }
     }
@@ -241,179 +204,348 @@ void AiGameState::render(Game &game) {
         }
     }
 
-    for (int playerIDX = 0; playerIDX < ((VariableManager::getShowCarsFirst()) ? 1 : VariableManager::getNetworksAmount()); ++playerIDX) {
-        Player &player = players[playerIDX];
-        Car &car = player.car;
+    // Cars only come from the snapshot, the simulation may be running on another thread
+    const Snapshot &snapshot = snapshots.read();
 
-        if (!player.isDead){
-            car.render(game.window);
+    // All cars, rays and markers go out in a few batched draw calls, cars outside of the view are skipped
+    selectShownCars(snapshot);
+    carBatch.begin(carSprite, game.window.getView());
 
-            if(VariableManager::getShowRays()){
-                auto &rays = player.rays;
-                auto &collisionMarkers = player.collisionMarkers;
+    // Large crowds become points, the leaders stay sprites so they can still be found
+    int threshold = VariableManager::getPointSpriteThreshold();
+    const std::vector<int> *spriteCars = &shownCars;
+    std::vector<int> leaders;
+    if (threshold > 0 && (int)shownCars.size() > threshold) {
+        for (int entry : shownCars) {
+            carBatch.addPoint({snapshot.positionX[entry], snapshot.positionY[entry]});
+        }
+        leaders = shownCars;
+        keepBest(leaders, VariableManager::getPointSpriteLeaders(), snapshot.score);
+        spriteCars = &leaders;
+    }
 
-                for (const auto& ray : rays) {
-                    game.window.draw(ray);
-                }
+    for (int entry : *spriteCars) {
+        sf::Vector2f position(snapshot.positionX[entry], snapshot.positionY[entry]);
+        bool visible = carBatch.addCar(position, snapshot.rotation[entry]);
 
-                for (const auto& marker : collisionMarkers) {
-                    game.window.draw(marker);
-                }
+        // Ray geometry only exists for cars that are on screen
+        if (visible) {
+            const sf::Vector2f *rayHits = snapshot.rayHits.data() + static_cast<size_t>(entry) * snapshot.rayCount;
+            for (int i = 0; i < snapshot.rayCount; ++i) {
+                carBatch.addRay(position, rayHits[i]);
             }
         }
     }
+    carBatch.draw(game.window);
+
+    std::string speed = simulationThread.joinable()
+            ? "\nSteps per second: " + std::to_string((int)snapshot.stepsPerSecond) + " (threaded)"
+            : "\nSteps per frame: " + std::to_string(stepsPerFrame) +
+              (VariableManager::getAdaptiveSimulationSpeed() ? " (adaptive)" : "");
 
     sf::Text t;
-    t.setString("Generation: " + std::to_string(currentGen) + "\nMutation Index: " +
-    std::to_string(VariableManager::getMutationIndex()) + "\nDelta Time: " +
-    std::to_string(variableDt) +
+    t.setString("Generation: " + std::to_string(snapshot.generation) + "\nMutation Index: " +
+    std::to_string(VariableManager::getMutationIndex()) + speed +
+    "\nCars drawn: " + std::to_string(carBatch.getCarCount()) + " (" +
+    (VariableManager::getShowCarsFirst() ? std::string("leader") : VariableManager::getRenderPolicy()) + ")" +
     "\nPlayers alive: " +
-    std::to_string(VariableManager::getNetworksAmount() - deadCars));
+    std::to_string(snapshot.aliveCars));
 
     t.setFillColor(sf::Color::Black);
     t.setCharacterSize(20);
     t.setPosition(10, 10);
     t.setFont(textFont);
     game.window.draw(t);
+
+    std::chrono::duration<float> elapsed = std::chrono::high_resolution_clock::now() - renderStart;
+    renderCost = elapsed.count();
 }
 
-void AiGameState::update(Game &game) {
-    sf::Vector2i &boundaries = this->getBoundaries();
-    auto &placedTileIDs = this->getPlacedTileIDs();
-    auto &placedTileSprites = this->getPlacedTileSprites();
-    auto &tiles = this->getTiles();
+bool AiGameState::isGenerationFinished() const {
+    float maxTime = VariableManager::getMaxGenerationTime();
+    return forceReset || population.getActiveCount() == 0 || (maxTime > 0.0f && generationTime >= maxTime) ||
+           (float)deadCars > (float)population.size() * VariableManager::getRestartOnDeadPercentage();
+}
+
+float AiGameState::currentScore(int i) const {
+    return population.points[i] - population.distanceRotated[i] / VariableManager::getRotationPenalty() -
+           population.distanceMovedBackwards[i] / VariableManager::getBackwardsMovementPenalty() - (!population.alive[i] ? -10.0f : 0.0f);
+}
+
+std::vector<float> AiGameState::calculateScores() {
+    std::vector<float> score(population.size(), 0.0f);
+    for (int i = 0; i < population.size(); ++i) {
+        score[i] = currentScore(i);
+    }
+    return score;
+}
+
+void AiGameState::selectShownCars(const Snapshot &snapshot) {
+    const std::string policy = VariableManager::getRenderPolicy();
+    int limit = std::max(0, VariableManager::getRenderCarLimit());
 
-    if(forceReset || (float)deadCars > (float)players.size() * VariableManager::getRestartOnDeadPercentage()){
+    shownCars.resize(snapshot.cars.size());
+    for (int entry = 0; entry < (int)shownCars.size(); ++entry) {
+        shownCars[entry] = entry;
+    }
 
-        std::vector<float> score(players.size(), 0.0f);
-        for (int i = 0; i < players.size(); ++i) {
-            score[i] = players[i].points - players[i].car.getDistanceRotated() / VariableManager::getRotationPenalty() -
-                    players[i].car.getDistanceMovedBackwards() / VariableManager::getBackwardsMovementPenalty() - (players[i].isDead ? -10.0f : 0.0f);
+    if (VariableManager::getShowCarsFirst()) {
+        keepBest(shownCars, 1, snapshot.score);
+    } else if (policy == "top") {
+        keepBest(shownCars, limit, snapshot.score);
+    } else if (policy == "sample") {
+        // The same cars every frame of a generation, so the sample does not flicker
+        if (sampleGeneration != snapshot.generation) {
+            std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+            sampleKey.resize(networkCount);
+            for (float &key : sampleKey) key = distribution(renderRandom);
+            sampleGeneration = snapshot.generation;
         }
-        network.breed(score, VariableManager::getAiWinners(), -VariableManager::getMutationIndex(), +VariableManager::getMutationIndex());
-        initializeCar();
-        initializeRays();
+        std::vector<float> key(snapshot.cars.size());
+        for (size_t entry = 0; entry < key.size(); ++entry) {
+            key[entry] = sampleKey[snapshot.cars[entry]];
+        }
+        keepBest(shownCars, limit, key);
+    }
+}
+
+void AiGameState::keepBest(std::vector<int> &entries, int count, const std::vector<float> &key) {
+    count = std::min(count, (int)entries.size());
+    std::partial_sort(entries.begin(), entries.begin() + count, entries.end(),
+                      [&key](int a, int b) { return key[a] > key[b]; });
+    entries.resize(count);
+}
+
+void AiGameState::publishSnapshot() {
+    Snapshot &snapshot = snapshots.write();
+    const std::vector<int> &active = population.activeCars;
+    size_t count = active.size();
+
+    // Sized once, later snapshots only overwrite
+    snapshot.cars.assign(active.begin(), active.end());
+    snapshot.positionX.resize(count);
+    snapshot.positionY.resize(count);
+    snapshot.rotation.resize(count);
+    snapshot.score.resize(count);
+    for (size_t entry = 0; entry < count; ++entry) {
+        int playerIDX = active[entry];
+        snapshot.positionX[entry] = population.positionX[playerIDX];
+        snapshot.positionY[entry] = population.positionY[playerIDX];
+        snapshot.rotation[entry] = population.rotation[playerIDX];
+        snapshot.score[entry] = currentScore(playerIDX);
+    }
 
-        forceReset = false;
+    snapshot.rayCount = VariableManager::getShowRays() ? population.getRayCount() : 0;
+    snapshot.rayHits.resize(count * snapshot.rayCount);
+    for (size_t entry = 0; entry < count && snapshot.rayCount > 0; ++entry) {
+        const sf::Vector2f *rayHits = population.getRayHits(active[entry]);
+        std::copy(rayHits, rayHits + snapshot.rayCount, snapshot.rayHits.begin() + entry * snapshot.rayCount);
+    }
+
+    snapshot.generation = currentGen;
+    snapshot.aliveCars = getAliveCars();
+    snapshot.stepsPerSecond = stepsPerSecond;
+    snapshots.publish();
+}
 
-        currentGen++;
-        deadCars = 0;
+void AiGameState::countSteps(int steps) {
+    stepsCounted += steps;
+    std::chrono::duration<float> elapsed = std::chrono::high_resolution_clock::now() - stepsCountedSince;
+    if (elapsed.count() >= 1.0f) {
+        stepsPerSecond = (float)stepsCounted / elapsed.count();
+        stepsCounted = 0;
+        stepsCountedSince = std::chrono::high_resolution_clock::now();
     }
+}
+
+void AiGameState::nextGeneration() {
+    std::vector<float> score = calculateScores();
+    lastBestScore = score.empty() ? 0.0f : *std::max_element(score.begin(), score.end());
 
-    performRaycasts(game);
+    if (selection) {
+        network.breed(score, *selection, VariableManager::getAiWinners(), -VariableManager::getMutationIndex(), +VariableManager::getMutationIndex());
+    } else {
+        network.breed(score, VariableManager::getAiWinners(), -VariableManager::getMutationIndex(), +VariableManager::getMutationIndex());
+    }
+    restartGeneration();
+
+    currentGen++;
+}
+
+void AiGameState::restartGeneration() {
+    initializeCar();
+
+    forceReset = false;
+    deadCars = 0;
+    generationTime = 0.0f;
+}
+
+void AiGameState::simulationStep() {
+    performRaycasts();
 
     // Car Movement
     this->updateAI();
+    this->updateCars();
+}
 
+void AiGameState::update(Game &game) {
     // Set DebugTimer
     this->setDebugTimer(getDebugTimer() + game.dt);
 
-    for (int playerIDX = 0; playerIDX < VariableManager::getNetworksAmount(); ++playerIDX) {
-        Player &player = players[playerIDX];
-        Car &car = player.car;
+    // The simulation thread only runs while this state is updated, so it stops behind the pause menu
+    if (simulationThread.joinable()) {
+        simulationPaused = false;
+        return;
+    }
 
-        if(!player.isDead) {
-            // update position
-            car.update(variableDt);
+    if (VariableManager::getAdaptiveSimulationSpeed()) {
+        stepsPerFrame = adaptiveStepCount();
+    }
 
-            // Check if checkpoint was reached
-            if (checkpoints.size() > 0) {
-                sf::Vector2f &positionCheckpoint = checkpoints[player.nextCheckpoint];
-                const sf::Vector2f &positionCar = car.getCarSprite().getPosition();
+    // The simulation only advances in fixed steps, the frame time just decides how many
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int step = 0; step < stepsPerFrame; ++step) {
+        if (isGenerationFinished()) {
+            nextGeneration();
+        }
 
-                sf::Vector2f distanceVector = positionCar - positionCheckpoint;
+        simulationStep();
+    }
+    std::chrono::duration<float> elapsed = std::chrono::high_resolution_clock::now() - start;
+    float cost = elapsed.count() / (float)stepsPerFrame;
+    stepCost = stepCost > 0.0f ? 0.8f * stepCost + 0.2f * cost : cost;
 
-                float distance = sqrtf(distanceVector.x * distanceVector.x + distanceVector.y * distanceVector.y);
+    countSteps(stepsPerFrame);
+    publishSnapshot();
+}
 
-                if (distance < VariableManager::getCheckpointRadius()) {
-                    player.points += VariableManager::getCheckpointPoints();
-                    if (player.nextCheckpoint < checkpoints.size() - 1) {
-                        player.nextCheckpoint++;
-                    } else {
-                        player.nextCheckpoint = 0;
-                    }
-                }
-            }
+void AiGameState::simulationLoop() {
+    while (simulationRunning) {
+        if (simulationPaused) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+        // Lets the window thread get the lock, a mutex does not guarantee it a turn
+        if (inputWaiting) {
+            std::this_thread::yield();
+            continue;
+        }
 
+        std::lock_guard<std::mutex> lock(simulationMutex);
+        if (isGenerationFinished()) {
+            nextGeneration();
+        }
+        simulationStep();
+        countSteps(1);
 
-            // Update death state
-            auto &rayDistances = player.rayDistances;
+        // Only copied once the last one was taken, so at most once per drawn frame
+        if (!snapshots.isPending()) {
+            publishSnapshot();
+        }
+    }
+}
 
-            if (getDebugTimer() >= 1.0f) {
-                // Print ray distances
-                for (size_t i = 0; i < rayDistances.size(); ++i) {
-                }
-                std::cout << "\n";
+void AiGameState::stopSimulation() {
+    simulationRunning = false;
+    if (simulationThread.joinable()) {
+        simulationThread.join();
+    }
+}
 
-                // Reset the timer
-                setDebugTimer(0.0f);
-            }
+std::unique_lock<std::mutex> AiGameState::lockSimulation() {
+    if (!simulationThread.joinable()) {
+        return {};
+    }
+    inputWaiting = true;
+    std::unique_lock<std::mutex> lock(simulationMutex);
+    inputWaiting = false;
+    return lock;
+}
 
-            // Get the car's transformed points
-            sf::Transform carTransform = car.getCarSprite().getTransform();
-            sf::FloatRect carLocalBounds = car.getCarSprite().getLocalBounds();
-
-            std::vector<sf::Vector2f> carPoints(4);
-            carPoints[0] = carTransform.transformPoint(sf::Vector2f(carLocalBounds.left, carLocalBounds.top));
-            carPoints[1] = carTransform.transformPoint(
-                    sf::Vector2f(carLocalBounds.left + carLocalBounds.width, carLocalBounds.top));
-            carPoints[2] = carTransform.transformPoint(sf::Vector2f(carLocalBounds.left + carLocalBounds.width,
-                                                                    carLocalBounds.top + carLocalBounds.height));
-            carPoints[3] = carTransform.transformPoint(
-                    sf::Vector2f(carLocalBounds.left, carLocalBounds.top + carLocalBounds.height));
-
-            bool allPointsOnRoad = true;
-
-            for (const auto &point: carPoints) {
-                bool pointOnRoad = false;
-
-                // Determine which tile the point is over
-                int tileSize = VariableManager::getTileSize();
-                sf::Vector2i pointTilePosition(
-                        static_cast<int>(point.x / tileSize),
-                        static_cast<int>(point.y / tileSize)
-                );
-
-                // Search neighboring tiles
-                int searchRadius = 1;
-                for (int dx = -searchRadius; dx <= searchRadius; ++dx) {
-                    for (int dy = -searchRadius; dy <= searchRadius; ++dy) {
-                        int x = pointTilePosition.x + dx;
-                        int y = pointTilePosition.y + dy;
-
-                        if (x < 0 || x >= boundaries.x || y < 0 || y >= boundaries.y)
-                            continue;
-
-                        int tileID = placedTileIDs[x][y];
-                        if (tileID < 0) continue;
-
-                        Tile &tile = tiles[tileID];
-                        const sf::ConvexShape &collisionShape = tile.collisionShape;
-
-                        sf::Sprite &tileSprite = placedTileSprites[x][y];
-
-                        sf::Transform combinedTransform = tileSprite.getTransform() * collisionShape.getTransform();
-
-                        if (isPointInPolygon(point, collisionShape, combinedTransform)) {
-                            pointOnRoad = true;
-                            break;
-                        }
-                    }
-                    if (pointOnRoad) break;
-                }
+int AiGameState::adaptiveStepCount() const {
+    if (stepCost <= 0.0f) return 1;
+
+    // A tenth of the frame stays free for input and display
+    float budget = VariableManager::getTargetFrameTime() / 1000.0f * 0.9f - renderCost;
+    return std::clamp((int)(budget / stepCost), 1, std::max(1, VariableManager::getMaxStepsPerFrame()));
+}
+
+void AiGameState::updateCars() {
+    generationTime += timestep;
+
+    // Every car only touches its own entries, the counter is the only shared result
+    std::atomic<int> newDeadCars{0};
+    threadPool.parallelFor(0, population.getActiveCount(), 256, [this, &newDeadCars](int begin, int end) {
+        newDeadCars += updateCars(begin, end);
+    });
+    deadCars += newDeadCars;
+
+    // Crashed and culled cars are skipped by every loop from the next step on
+    if (newDeadCars > 0) population.compactActive();
+}
+
+bool AiGameState::shouldCull(int playerIDX) const {
+    // Both policies measure progress in checkpoints
+    if (checkpoints.empty()) return false;
+
+    float timeout = VariableManager::getStagnationTimeout();
+    if (timeout > 0.0f && population.timeSinceCheckpoint[playerIDX] > timeout) return true;
 
-                if (!pointOnRoad) {
-                    allPointsOnRoad = false;
-                    break; // One point is off the road
+    // One checkpoint of slack, otherwise every car would be culled before it can reach the first one
+    float rate = VariableManager::getMinProgressRate();
+    return rate > 0.0f && (float)population.checkpointsReached[playerIDX] + 1.0f < rate * generationTime;
+}
+
+int AiGameState::updateCars(int begin, int end) {
+    int newDeadCars = 0;
+
+    // update position of the active cars in the range at once
+    population.updateActive(timestep, begin, end);
+
+    for (int activeIDX = begin; activeIDX < end; ++activeIDX) {
+        int playerIDX = population.activeCars[activeIDX];
+        population.timeSinceCheckpoint[playerIDX] += timestep;
+
+        // Check if checkpoint was reached
+        if (checkpoints.size() > 0) {
+            int &nextCheckpoint = population.nextCheckpoint[playerIDX];
+            sf::Vector2f &positionCheckpoint = checkpoints[nextCheckpoint];
+
+            float dx = population.positionX[playerIDX] - positionCheckpoint.x;
+            float dy = population.positionY[playerIDX] - positionCheckpoint.y;
+            float distance = sqrtf(dx * dx + dy * dy);
+
+            if (distance < VariableManager::getCheckpointRadius()) {
+                population.points[playerIDX] += VariableManager::getCheckpointPoints();
+                population.checkpointsReached[playerIDX]++;
+                population.timeSinceCheckpoint[playerIDX] = 0.0f;
+                if (nextCheckpoint < checkpoints.size() - 1) {
+                    nextCheckpoint++;
+                } else {
+                    nextCheckpoint = 0;
                 }
             }
+        }
+
+        if (shouldCull(playerIDX)) {
+            newDeadCars++;
+            population.alive[playerIDX] = 0;
+            continue;
+        }
 
-            if (!allPointsOnRoad) {
-                deadCars++;
-                player.isDead = true;
+        // Update death state, all four corners of the car have to be on the road
+        sf::Vector2f carPoints[4];
+        population.getCorners(playerIDX, carPoints);
+
+        for (const auto &point: carPoints) {
+            if (!isPointOnTrack(point)) {
+                newDeadCars++;
+                population.alive[playerIDX] = 0;
+                break; // One point is off the road
             }
         }
     }
+    return newDeadCars;
 }
 
 void AiGameState::handleInput(Game &game) {
@@ -425,10 +557,13 @@ void AiGameState::handleInput(Game &game) {
         }
         if (isPauseKeyPressed(event)) {
             std::cout << "[DEBUG] Pause key pressed\n";
+            simulationPaused = true;
             game.pushState(std::make_shared<PauseState>());
         }
 
+        // Everything below that changes the simulation takes the lock first
         if (event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::R){
+            auto lock = lockSimulation();
             forceReset = true;
         }
 
@@ -436,6 +571,8 @@ void AiGameState::handleInput(Game &game) {
             VariableManager::setShowCheckpoints(!VariableManager::getShowCheckpoints());
         }
         if (event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::Num2){
+            // publishSnapshot reads it on the simulation thread
+            auto lock = lockSimulation();
             VariableManager::setShowRays(!VariableManager::getShowRays());
         }
         if (event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::Num3){
@@ -444,35 +581,55 @@ void AiGameState::handleInput(Game &game) {
         if (event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::Num4){
             VariableManager::setShowCarsFirst(!VariableManager::getShowCarsFirst());
         }
+        if (event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::Num5){
+            // all, top, sample
+            std::string policy = VariableManager::getRenderPolicy();
+            VariableManager::setRenderPolicy(policy == "all" ? "top" : policy == "top" ? "sample" : "all");
+        }
+
+        if (event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::F3){
+            VariableManager::setFpsCounter(!VariableManager::getFpsCounter());
+        }
+
+        if (event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::T){
+            VariableManager::setAdaptiveSimulationSpeed(!VariableManager::getAdaptiveSimulationSpeed());
+        }
+
+        if (event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::C){
+            auto lock = lockSimulation();
+            saveCheckpoints();
+        }
 
         if (event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::S){
+            auto lock = lockSimulation();
             std::cout << "\nNetwork saved: " << network.save("resources/Networks/network0.json", VariableManager::getAiWinners()) <<
             "\n==========================================\n";
         }
 
         if (event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::L){
+            auto lock = lockSimulation();
             std::cout << "\nNetwork loaded: " << network.load("resources/Networks/network0.json") <<
                       "\n==========================================\n";
-            initializeCar();
-            initializeRays();
-            deadCars = 0;
+            restartGeneration();
         }
 
         if(event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left){
             sf::Vector2i mousePos = sf::Mouse::getPosition(game.window);
+            auto lock = lockSimulation();
             checkpoints.emplace_back(mousePos.x, mousePos.y);
         }
         if (event.type == sf::Event::MouseWheelScrolled) {
+            auto lock = lockSimulation();
             if (event.mouseWheelScroll.delta > 0) {
                 if(sf::Keyboard::isKeyPressed(sf::Keyboard::LShift)){
-                    variableDt *= 2.0f;
+                    stepsPerFrame = std::min(stepsPerFrame * 2, std::max(1, VariableManager::getMaxStepsPerFrame()));
                 }else{
                     VariableManager::setMutationIndex(VariableManager::getMutationIndex() + 0.01f);
                 }
 
             } else if (event.mouseWheelScroll.delta < 0) {
                 if(sf::Keyboard::isKeyPressed(sf::Keyboard::LShift)){
-                    variableDt /= 2.0f;
+                    stepsPerFrame = std::max(stepsPerFrame / 2, 1);
                 }else{
                     VariableManager::setMutationIndex(VariableManager::getMutationIndex() - 0.01f);
                 }
@@ -483,35 +640,54 @@ void AiGameState::handleInput(Game &game) {
 }
 
 void AiGameState::updateAI() {
-    int raySize = rayAngles.size();
+    int raySize = population.getRayCount();
+    int networks = population.size();
+    int active = population.getActiveCount();
+    const std::vector<int> &activeCars = population.activeCars;
+
+    int outputNeurons = OUTPUT_NEURONS;
+    std::vector<float> outputVec(outputNeurons * networks, 0.0f);
+
+    // The ray distances are already stored contiguously per car, which is the layout of the input batch.
+    // Car i is driven by network i, so only the networks of the active cars are evaluated.
+    if (VariableManager::getUseCpuInference()) {
+        network.sync_host();
+        threadPool.parallelFor(0, active, 256, [this, &outputVec, &activeCars](int begin, int end) {
+            network.feed_forward_host(population.rayDistances.data(), outputVec.data(), activeCars.data(), begin, end);
+        });
+    } else if (active == networks) {
+        af::array inputAf(raySize, 1, networks, population.rayDistances.data());
+        af::array outputAf = network.feed_forward(inputAf);
+        outputAf.host(outputVec.data());
+    } else if (active > 0) {
+        std::vector<float> inputVec((size_t)raySize * active);
+        for (int k = 0; k < active; ++k) {
+            const float *rays = population.getRayDistances(activeCars[k]);
+            std::copy(rays, rays + raySize, &inputVec[(size_t)k * raySize]);
+        }
 
-    std::vector<float> inputData(raySize * VariableManager::getNetworksAmount(), 0.0f);
-    for (int i = 0; i < VariableManager::getNetworksAmount(); ++i) {
-        for (int r = 0; r < raySize; ++r) {
-            inputData[i * raySize + r] = players[i].rayDistances[r];
+        af::array inputAf(raySize, 1, active, inputVec.data());
+        af::array indicesAf(active, activeCars.data());
+        std::vector<float> compactOutput((size_t)outputNeurons * active);
+        network.feed_forward(inputAf, indicesAf).host(compactOutput.data());
+
+        for (int k = 0; k < active; ++k) {
+            std::copy(&compactOutput[(size_t)k * outputNeurons], &compactOutput[(size_t)(k + 1) * outputNeurons],
+                      &outputVec[(size_t)activeCars[k] * outputNeurons]);
         }
     }
-    af::array inputAf(raySize, 1, VariableManager::getNetworksAmount(), inputData.data());
-    af::array outputAf = network.feed_forward(inputAf);
-    int outputNeurons = (int)outputAf.dims()[0];
-    std::vector<float> outputVec(outputNeurons * VariableManager::getNetworksAmount(), 0.0f);
-    outputAf.host(outputVec.data());
-
 
-    for (int playerIDX = 0; playerIDX < VariableManager::getNetworksAmount(); ++playerIDX) {
-        Player &player = players[playerIDX];
-        Car &car = player.car;
-        auto &rayDistances = player.rayDistances;
+    for (int playerIDX : activeCars) {
         if(outputVec[playerIDX * outputNeurons + 0] > 0.0f){
-            car.setAcceleration(car.getAccelerationConstant());
+            population.acceleration[playerIDX] = population.getAccelerationConstant();
         }else{
-            car.setAcceleration(-car.getAccelerationConstant());
+            population.acceleration[playerIDX] = -population.getAccelerationConstant();
         }
 
         if(outputVec[playerIDX * outputNeurons + 1] > 0.0f){
-            car.setAngularAcceleration(-car.getAngularAccelerationConstant());
+            population.angularAcceleration[playerIDX] = -population.getAngularAccelerationConstant();
         }else{
-            car.setAngularAcceleration(car.getAngularAccelerationConstant());
+            population.angularAcceleration[playerIDX] = population.getAngularAccelerationConstant();
         }
     }
 }
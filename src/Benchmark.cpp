@@ -0,0 +1,81 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#include "Benchmark.h"
+
+size_t Benchmark::allocatedBytes() {
+    size_t allocBytes = 0, allocBuffers = 0, lockBytes = 0, lockBuffers = 0;
+    af::deviceMemInfo(&allocBytes, &allocBuffers, &lockBytes, &lockBuffers);
+    return allocBytes;
+}
+
+int Benchmark::inference(int networks, const std::vector<int> &batchSizes, int iterations) {
+    NeuralNetwork network(VariableManager::getAiTopology(), VariableManager::getAiActivations(),
+                          -VariableManager::getAiInitialRandomValuesMax(), +VariableManager::getAiInitialRandomValuesMax(),
+                          VariableManager::getAiInitialRandomValuesUniform(), networks);
+
+    std::cout << "[BENCHMARK] Inference of " << networks << " networks, " << Utility::sizeToString(network.bytes())
+              << " of weights\n";
+
+    for (int batchSize : batchSizes) {
+        af::array input = af::randu(VariableManager::getAiTopology()[0], 1, networks, batchSize) * 1000.0f;
+
+        for (int tiled = 1; tiled >= 0; --tiled) {
+            // Warm up, then measure what a single call leaves in the memory manager
+            af::array output = tiled ? network.feed_forward_tiled(input) : network.feed_forward(input);
+            output.eval();
+            af::sync();
+            output = af::array();
+
+            af::deviceGC();
+            size_t before = allocatedBytes();
+            output = tiled ? network.feed_forward_tiled(input) : network.feed_forward(input);
+            output.eval();
+            af::sync();
+            size_t allocated = allocatedBytes() - before;
+
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                output = tiled ? network.feed_forward_tiled(input) : network.feed_forward(input);
+                output.eval();
+            }
+            af::sync();
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+            std::cout << "[BENCHMARK] batch " << batchSize << (tiled ? ", tiled:   " : ", batched: ")
+                      << Utility::sizeToString(allocated) << " allocated, "
+                      << elapsed.count() / iterations << " ms per call\n";
+        }
+    }
+    return 0;
+}
+
+int Benchmark::runFromArguments(int argc, char *argv[]) {
+    std::string name;
+    int networks = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--benchmark" && hasValue) {
+            name = argv[++i];
+        } else if (arg == "--networks" && hasValue) {
+            networks = std::stoi(argv[++i]);
+        }
+    }
+
+    VariableManager::loadFromJson(VariableManager::getPathToConfig());
+    Utility::setup();
+    if (networks <= 0) {
+        networks = VariableManager::getNetworksAmount();
+    }
+
+    if (name == "inference") {
+        return inference(networks, {1, 16, 256});
+    }
+
+    std::cerr << "Usage: IntelliDrive --benchmark inference [--networks N]\n";
+    return 1;
+}
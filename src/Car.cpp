@@ -114,7 +114,6 @@ void Car::resetRotationAngle() {
 
 void Car::render(sf::RenderWindow& window) {
     window.draw(carSprite);
-    carSprite.setScale(0.35f, 0.35f);
 }
 
 sf::FloatRect Car::getBounds() const {
@@ -124,6 +123,9 @@ sf::FloatRect Car::getBounds() const {
 void Car::applyData(carData &data) {
     carSprite = {};
     carSprite.setTexture(data.carTexture);
+    // The texture rect comes from the image size so headless cars keep their real collision bounds
+    carSprite.setTextureRect(sf::IntRect(0, 0, static_cast<int>(data.carTextureSize.x), static_cast<int>(data.carTextureSize.y)));
+    carSprite.setScale(0.35f, 0.35f);
 
     maxSpeedValue = static_cast<float>(data.MaxSpeed);
     handlingValue = static_cast<float>(data.Handling);
@@ -0,0 +1,97 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#include "CarBatch.h"
+
+#include <algorithm>
+#include <cmath>
+
+void CarBatch::begin(const sf::Sprite &sprite, const sf::View &view) {
+    cars.clear();
+    rays.clear();
+    markers.clear();
+    points.clear();
+
+    texture = sprite.getTexture();
+    color = sprite.getColor();
+
+    sf::FloatRect bounds = sprite.getLocalBounds();
+    sf::IntRect rect = sprite.getTextureRect();
+    sf::Vector2f origin = sprite.getOrigin();
+    sf::Vector2f scale = sprite.getScale();
+
+    sf::Vector2f local[4] = {{0, 0}, {bounds.width, 0}, {bounds.width, bounds.height}, {0, bounds.height}};
+    radius = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+        corners[i] = {(local[i].x - origin.x) * scale.x, (local[i].y - origin.y) * scale.y};
+        radius = std::max(radius, std::hypot(corners[i].x, corners[i].y));
+    }
+
+    float left = static_cast<float>(rect.left);
+    float top = static_cast<float>(rect.top);
+    float right = left + static_cast<float>(rect.width);
+    float bottom = top + static_cast<float>(rect.height);
+    texCoords[0] = {left, top};
+    texCoords[1] = {right, top};
+    texCoords[2] = {right, bottom};
+    texCoords[3] = {left, bottom};
+
+    sf::Vector2f size = view.getSize();
+    visible = sf::FloatRect(view.getCenter() - size / 2.0f, size);
+}
+
+bool CarBatch::isVisible(const sf::Vector2f &position) const {
+    return position.x + radius >= visible.left && position.x - radius <= visible.left + visible.width &&
+           position.y + radius >= visible.top && position.y - radius <= visible.top + visible.height;
+}
+
+bool CarBatch::addCar(const sf::Vector2f &position, float rotation) {
+    if (!isVisible(position)) {
+        return false;
+    }
+
+    // Same transform as sf::Transformable, rotation in degrees around the position
+    float radians = rotation * 3.14159265f / 180.0f;
+    float c = std::cos(radians);
+    float s = std::sin(radians);
+    for (int i = 0; i < 4; ++i) {
+        sf::Vector2f corner(position.x + corners[i].x * c - corners[i].y * s,
+                            position.y + corners[i].x * s + corners[i].y * c);
+        cars.append(sf::Vertex(corner, color, texCoords[i]));
+    }
+    return true;
+}
+
+bool CarBatch::addPoint(const sf::Vector2f &position) {
+    if (!isVisible(position)) {
+        return false;
+    }
+    points.append(sf::Vertex(position, sf::Color(255, 200, 0)));
+    return true;
+}
+
+void CarBatch::addRay(const sf::Vector2f &start, const sf::Vector2f &end) {
+    rays.append(sf::Vertex(start, sf::Color(0, 255, 255, 255)));
+    rays.append(sf::Vertex(end, sf::Color(0, 255, 255, 255)));
+
+    // Hit marker, 10 pixels wide like the circles before
+    const float half = 5.0f;
+    markers.append(sf::Vertex(end + sf::Vector2f(-half, -half), sf::Color::Red));
+    markers.append(sf::Vertex(end + sf::Vector2f(half, -half), sf::Color::Red));
+    markers.append(sf::Vertex(end + sf::Vector2f(half, half), sf::Color::Red));
+    markers.append(sf::Vertex(end + sf::Vector2f(-half, half), sf::Color::Red));
+}
+
+void CarBatch::draw(sf::RenderTarget &target) const {
+    if (points.getVertexCount() > 0) {
+        target.draw(points);
+    }
+    if (cars.getVertexCount() > 0) {
+        target.draw(cars, sf::RenderStates(texture));
+    }
+    if (rays.getVertexCount() > 0) {
+        target.draw(rays);
+        target.draw(markers);
+    }
+}
@@ -0,0 +1,336 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#include "DistributedTrainer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+DistributedTrainer::DistributedTrainer(const std::string &levelFile, int generations, int workers,
+                                       int maxStepsPerGeneration, const std::string &savePath)
+        : levelFile(levelFile), savePath(savePath), generations(generations),
+          maxStepsPerGeneration(maxStepsPerGeneration), workers(std::max(1, workers)) {}
+
+#ifdef _WIN32
+
+bool DistributedTrainer::sendMessage(int, MessageType, uint32_t, const std::vector<float> &) { return false; }
+bool DistributedTrainer::receiveMessage(int, MessageHeader &, std::vector<float> &) { return false; }
+int DistributedTrainer::acceptWorker(int, const std::vector<int> &) { return -1; }
+bool DistributedTrainer::spawnWorkers(const std::string &, const std::string &, std::vector<int> &) { return false; }
+
+int DistributedTrainer::run(const std::string &) {
+    std::cerr << "[DISTRIBUTED] Worker processes are only supported on POSIX systems\n";
+    return 1;
+}
+
+int DistributedTrainer::runWorker(int, char *[]) {
+    std::cerr << "[DISTRIBUTED] Worker processes are only supported on POSIX systems\n";
+    return 1;
+}
+
+#else
+
+namespace {
+    bool writeAll(int socket, const void *data, size_t size) {
+        auto *bytes = static_cast<const char *>(data);
+        while (size > 0) {
+            ssize_t written = send(socket, bytes, size, MSG_NOSIGNAL);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return false;
+            bytes += written;
+            size -= (size_t)written;
+        }
+        return true;
+    }
+
+    bool readAll(int socket, void *data, size_t size) {
+        auto *bytes = static_cast<char *>(data);
+        while (size > 0) {
+            ssize_t received = recv(socket, bytes, size, 0);
+            if (received < 0 && errno == EINTR) continue;
+            if (received <= 0) return false;
+            bytes += received;
+            size -= (size_t)received;
+        }
+        return true;
+    }
+
+    sockaddr_un socketAddress(const std::string &path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        return address;
+    }
+}
+
+bool DistributedTrainer::sendMessage(int socket, MessageType type, uint32_t count, const std::vector<float> &payload) {
+    MessageHeader header{(uint32_t)type, count, payload.size() * sizeof(float)};
+    return writeAll(socket, &header, sizeof(header)) && writeAll(socket, payload.data(), header.bytes);
+}
+
+bool DistributedTrainer::receiveMessage(int socket, MessageHeader &header, std::vector<float> &payload) {
+    if (!readAll(socket, &header, sizeof(header)) || header.bytes % sizeof(float) != 0) {
+        return false;
+    }
+    payload.resize(header.bytes / sizeof(float));
+    return readAll(socket, payload.data(), header.bytes);
+}
+
+int DistributedTrainer::acceptWorker(int listener, const std::vector<int> &pids) {
+    // A worker that died before connecting would leave accept waiting forever
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::seconds(60)) {
+        pollfd request{listener, POLLIN, 0};
+        int result = poll(&request, 1, 200);
+        if (result < 0 && errno != EINTR) {
+            return -1;
+        }
+        if (result > 0) {
+            return accept(listener, nullptr, nullptr);
+        }
+
+        for (int pid : pids) {
+            int status = 0;
+            if (waitpid(pid, &status, WNOHANG) == pid) {
+                std::cerr << "[DISTRIBUTED] Worker process " << pid << " exited with "
+                          << (WIFEXITED(status) ? WEXITSTATUS(status) : -1) << " before connecting\n";
+                return -1;
+            }
+        }
+    }
+    std::cerr << "[DISTRIBUTED] No worker connected within 60 s\n";
+    return -1;
+}
+
+bool DistributedTrainer::spawnWorkers(const std::string &executable, const std::string &socketPath, std::vector<int> &pids) {
+    for (int i = 0; i < workers; ++i) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "[DISTRIBUTED] Could not start worker " << i << ": " << std::strerror(errno) << "\n";
+            return false;
+        }
+
+        if (pid == 0) {
+            std::string index = std::to_string(i);
+            std::string steps = std::to_string(maxStepsPerGeneration);
+            // The cores are shared between the workers
+            int hardwareThreads = std::max(1, (int)std::thread::hardware_concurrency());
+            std::string threads = std::to_string(std::max(1, hardwareThreads / workers));
+            execl(executable.c_str(), executable.c_str(), "--worker", socketPath.c_str(), index.c_str(),
+                  levelFile.c_str(), steps.c_str(), threads.c_str(), (char *)nullptr);
+            _exit(127);
+        }
+        pids.push_back(pid);
+    }
+    return true;
+}
+
+int DistributedTrainer::run(const std::string &executable) {
+    std::vector<carData> cars;
+    if (!HeadlessTrainer::loadResources(cars)) {
+        return 1;
+    }
+    if (seed != 0) {
+        VariableManager::setSeed(seed);
+    }
+
+    // Every worker needs at least one network, an empty shard would fall back to NETWORKS_AMOUNT
+    int networks = VariableManager::getNetworksAmount();
+    if (workers > networks) {
+        std::cout << "[DISTRIBUTED] Only " << networks << " networks, using " << networks << " workers\n";
+        workers = std::max(1, networks);
+    }
+
+    std::string socketPath = "/tmp/intellidrive-" + std::to_string(getpid()) + ".sock";
+    unlink(socketPath.c_str());
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = socketAddress(socketPath);
+    if (listener < 0 || bind(listener, (sockaddr *)&address, sizeof(address)) != 0 || listen(listener, workers) != 0) {
+        std::cerr << "[DISTRIBUTED] Could not listen on " << socketPath << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+
+    std::vector<int> pids;
+    std::vector<int> connections(workers, -1);
+    bool ready = spawnWorkers(executable, socketPath, pids);
+
+    // Workers may connect in any order, the hello tells which shard belongs to the connection
+    for (int i = 0; ready && i < workers; ++i) {
+        int connection = acceptWorker(listener, pids);
+        MessageHeader header{};
+        std::vector<float> payload;
+        if (connection < 0 || !receiveMessage(connection, header, payload) ||
+            header.type != (uint32_t)MessageType::Hello || header.count >= (uint32_t)workers) {
+            std::cerr << "[DISTRIBUTED] A worker failed to start\n";
+            ready = false;
+            break;
+        }
+        connections[header.count] = connection;
+    }
+    close(listener);
+    unlink(socketPath.c_str());
+
+    // Seeded like a single AiGameState, the workers only simulate and need no randomness
+    unsigned int runSeed = RunManifest::runSeed();
+    NeuralNetwork network(VariableManager::getAiTopology(), VariableManager::getAiActivations(), networks);
+    network.seed(RunManifest::deriveSeed(runSeed, 0, RunManifest::Stream::Initialization));
+    network.randomize(-VariableManager::getAiInitialRandomValuesMax(), +VariableManager::getAiInitialRandomValuesMax(),
+                      VariableManager::getAiInitialRandomValuesUniform());
+    network.seed(RunManifest::deriveSeed(runSeed, 0, RunManifest::Stream::Breeding));
+
+    std::unique_ptr<SelectionStrategy> selection;
+    if (VariableManager::getSelectionStrategy() != "truncation") {
+        selection = SelectionStrategy::create(VariableManager::getSelectionStrategy(), VariableManager::getTournamentSize(),
+                                              VariableManager::getRankPressure());
+        selection->seed((unsigned int)RunManifest::deriveSeed(runSeed, 0, RunManifest::Stream::Selection));
+    }
+
+    if (ready) {
+        std::cout << "[DISTRIBUTED] Training on " << levelFile << " for " << generations << " generations with "
+                  << networks << " networks on " << workers << " workers, seed " << runSeed << "\n";
+    }
+
+    auto trainingStart = std::chrono::high_resolution_clock::now();
+    for (int generation = 0; ready && generation < generations; ++generation) {
+        auto generationStart = std::chrono::high_resolution_clock::now();
+
+        // Every worker gets a contiguous shard, all of them simulate at the same time
+        for (int i = 0; i < workers && ready; ++i) {
+            int begin = networks * i / workers;
+            int end = networks * (i + 1) / workers;
+            ready = sendMessage(connections[i], MessageType::Evaluate, end - begin, network.export_networks(begin, end));
+        }
+
+        std::vector<float> fitness(networks, 0.0f);
+        for (int i = 0; i < workers && ready; ++i) {
+            int begin = networks * i / workers;
+            int end = networks * (i + 1) / workers;
+
+            MessageHeader header{};
+            std::vector<float> scores;
+            ready = receiveMessage(connections[i], header, scores) && header.type == (uint32_t)MessageType::Fitness &&
+                    scores.size() == (size_t)(end - begin);
+            if (ready) std::copy(scores.begin(), scores.end(), fitness.begin() + begin);
+        }
+        if (!ready) {
+            std::cerr << "[DISTRIBUTED] Lost the connection to a worker\n";
+            break;
+        }
+
+        float bestScore = *std::max_element(fitness.begin(), fitness.end());
+        if (selection) {
+            network.breed(fitness, *selection, VariableManager::getAiWinners(), -VariableManager::getMutationIndex(), +VariableManager::getMutationIndex());
+        } else {
+            network.breed(fitness, VariableManager::getAiWinners(), -VariableManager::getMutationIndex(), +VariableManager::getMutationIndex());
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - generationStart;
+        std::cout << "[DISTRIBUTED] Generation " << generation << ": best score " << bestScore << ", "
+                  << elapsed.count() << " s\n";
+    }
+
+    for (int connection : connections) {
+        if (connection < 0) continue;
+        sendMessage(connection, MessageType::Stop, 0, {});
+        close(connection);
+    }
+    for (int pid : pids) {
+        if (!ready) kill(pid, SIGTERM);
+        waitpid(pid, nullptr, 0);
+    }
+    if (!ready) {
+        return 1;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - trainingStart;
+    std::cout << "[DISTRIBUTED] Finished " << generations << " generations in " << elapsed.count() << " s\n";
+
+    if (!savePath.empty()) {
+        std::cout << "[DISTRIBUTED] Network saved: " << network.save(savePath, VariableManager::getAiWinners()) << "\n";
+    }
+    return 0;
+}
+
+int DistributedTrainer::runWorker(int argc, char *argv[]) {
+    std::string socketPath, levelFile;
+    int index = -1;
+    int maxSteps = 0;
+    int threads = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--worker" && i + 5 < argc) {
+            socketPath = argv[i + 1];
+            index = std::stoi(argv[i + 2]);
+            levelFile = argv[i + 3];
+            maxSteps = std::stoi(argv[i + 4]);
+            threads = std::stoi(argv[i + 5]);
+            break;
+        }
+    }
+    if (socketPath.empty() || index < 0) {
+        std::cerr << "Usage: IntelliDrive --worker <socket> <index> <level.csv> <steps> <threads>\n";
+        return 1;
+    }
+
+    // Connected first, so the coordinator sees the worker go away if loading the resources fails
+    int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = socketAddress(socketPath);
+    if (connection < 0 || connect(connection, (sockaddr *)&address, sizeof(address)) != 0 ||
+        !sendMessage(connection, MessageType::Hello, (uint32_t)index, {})) {
+        std::cerr << "[DISTRIBUTED] Worker " << index << " could not connect to " << socketPath << "\n";
+        return 1;
+    }
+
+    std::vector<carData> cars;
+    if (!HeadlessTrainer::loadResources(cars)) {
+        close(connection);
+        return 1;
+    }
+    int carIndex = std::clamp(VariableManager::getSelectedCarIndex(), 0, (int)cars.size() - 1);
+
+    // Created with the size of the first shard, the shard of a worker keeps its size
+    std::unique_ptr<AiGameState> state;
+    MessageHeader header{};
+    std::vector<float> payload;
+
+    while (receiveMessage(connection, header, payload) && header.type == (uint32_t)MessageType::Evaluate) {
+        if (!state || state->getNetwork().networks() != (int)header.count) {
+            state = std::make_unique<AiGameState>(levelFile, cars[carIndex], (int)header.count, threads);
+        }
+        if (!state->getNetwork().import_networks(payload.data(), payload.size())) {
+            break;
+        }
+        state->restartGeneration();
+
+        int steps = 0;
+        while (!state->isGenerationFinished()) {
+            state->simulationStep();
+            if (maxSteps > 0 && ++steps >= maxSteps) {
+                state->requestReset();
+            }
+        }
+
+        if (!sendMessage(connection, MessageType::Fitness, header.count, state->calculateScores())) {
+            break;
+        }
+    }
+
+    close(connection);
+    return 0;
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include "../include/Game.h"
 #include "../include/MenuState.h"
 #include "../include/ResourceManager.h"
+#include "../include/MetricsManager.h"
 
 Game::Game() : window(sf::VideoMode(1920, 1080), "IntelliDrive", sf::Style::Fullscreen)
 {
@@ -19,7 +20,7 @@ Game::Game() : window(sf::VideoMode(1920, 1080), "IntelliDrive", sf::Style::Full
 
     car = {};
     Utility::setup();
-    loadCarData("resources/config/cars.csv");
+    loadCarData(VariableManager::getPathToCarConfig());
     std::cout << "[DEBUG] Loading tiles from CSV\n";
     car.applyData(cars[0]);
     pushState(std::make_shared<MenuState>());
@@ -27,6 +28,10 @@ Game::Game() : window(sf::VideoMode(1920, 1080), "IntelliDrive", sf::Style::Full
     initializeText(fpsText, 100.f, 100.f);
     initializeText(avgText, 100.f, 140.f);
     initializeText(lowsText, 100.f, 170.f);
+    initializeText(metricsText, 0.f, 10.f);
+    metricsText.setCharacterSize(18);
+    metricsText.setOutlineColor(sf::Color::Black);
+    metricsText.setOutlineThickness(1.0f);
 
     window.setFramerateLimit(144);
 }
@@ -44,17 +49,32 @@ void Game::run() {
         dt = elapsedTime.count() / 1e9;
         previousTime = currentTime;
 
+        MetricsManager &metrics = MetricsManager::getInstance();
+        metrics.frameStart();
+
         if (auto currentState = getCurrentState()) {
             currentState->handleInput(*this);
             currentState->update(*this);
             window.clear();
             currentState->render(*this);
             //calculateAndDisplayFPS();
+            if (VariableManager::getFpsCounter()) {
+                drawMetrics();
+            }
             window.display();
         }
+
+        metrics.frameEnd();
     }
 }
 
+void Game::drawMetrics() {
+    // Values of the previous frame, the current one is still running
+    metricsText.setString(MetricsManager::getInstance().report(VariableManager::getMetricsMode() == "advanced"));
+    metricsText.setPosition(window.getSize().x - metricsText.getLocalBounds().width - 20.f, 10.f);
+    window.draw(metricsText);
+}
+
 void Game::pushState(std::shared_ptr<State> state) {
     states.push_back(state);
 }
@@ -76,24 +96,7 @@ std::shared_ptr<State> Game::getCurrentState() {
 }
 
 void Game::loadCarData(std::string path) {
-    std::ifstream inputFile(path);
-    if (!inputFile.is_open()) {
-        std::cerr << "ERROR: Error opening file!" << "\n";
-        return;
-    }
-
-    std::string line;
-    int row = 0;
-
-    while (getline(inputFile, line)) {
-        if (row != 0) {
-            carData data;
-            parseCarDataLine(line, data);
-            cars.emplace_back(data);
-        }
-        row++;
-    }
-    inputFile.close();
+    ResourceManager::loadCarsFromCSV(path, cars);
 }
 
 void Game::calculateAndDisplayFPS() {
@@ -123,52 +126,6 @@ void Game::initializeText(sf::Text& text, float x, float y) {
     text.setPosition(x, y);
 }
 
-void Game::parseCarDataLine(const std::string& line, carData& data) {
-    std::stringstream ss(line);
-    std::string token;
-    int entry = 0;
-
-    while (getline(ss, token, ',')) {
-        if (!token.empty()) {
-            switch (entry) {
-            case 0:
-                data.name = token;
-                break;
-            case 1:
-                ResourceManager::loadTexture("CarTexture_" + data.name, token);
-                data.carTexture = ResourceManager::getTexture("CarTexture_" + data.name);
-                break;
-            case 2:
-                data.MaxSpeed = std::stof(token);
-                break;
-            case 3:
-                data.Handling = std::stof(token);
-                break;
-            case 4:
-                data.Acceleration = std::stof(token);
-                break;
-            case 5:
-                data.weight = std::stof(token);
-                break;
-            case 6:
-                data.power = std::stof(token);
-                break;
-            case 7:
-                data.torque = std::stof(token);
-                break;
-            case 8:
-                data.driveType = token;
-                break;
-            case 9:
-                ResourceManager::loadTexture("LogoTexture_" + data.name, token);
-                data.logoTexture = ResourceManager::getTexture("LogoTexture_" + data.name);
-                break;
-            }
-        }
-        entry++;
-    }
-}
-
 float Game::calculateAverageFPS() const {
     float sumFrameTimes = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0f);
     return frameTimes.empty() ? 0.0f : 1.0f / (sumFrameTimes / frameTimes.size());
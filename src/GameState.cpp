@@ -40,36 +40,13 @@ void GameState::initializeCar() {
 }
 
 void GameState::render(Game &game) {
-    sf::Vector2i &boundaries = this->getBoundaries();
-    auto &backgroundSprite = this->getBackgroundSprite();
-    auto &placedTileIDs = this->getPlacedTileIDs();
-    auto &placedTileSprites = this->getPlacedTileSprites();
-    auto &tiles = this->getTiles();
-
     game.window.clear();
-    game.window.draw(backgroundSprite);
-
-    for (int x = 0; x < boundaries.x; ++x) {
-        for (int y = 0; y < boundaries.y; ++y) {
-            game.window.draw(placedTileSprites[x][y]);
-
-            int tileID = placedTileIDs[x][y];
-            if (tileID >= 0) {
-                Tile& tile = tiles[tileID];
-                sf::ConvexShape collisionShape = tile.collisionShape;
-            }
-        }
-    }
+    drawLevel(game.window);
 
     car.render(game.window);
 }
 
 void GameState::update(Game &game) {
-    sf::Vector2i &boundaries = this->getBoundaries();
-    auto &placedTileIDs = this->getPlacedTileIDs();
-    auto &placedTileSprites = this->getPlacedTileSprites();
-    auto &tiles = this->getTiles();
-
     car.update(game.dt);
 
     // Get the car's transformed points
@@ -85,44 +62,7 @@ void GameState::update(Game &game) {
     bool allPointsOnRoad = true;
 
     for (const auto& point : carPoints) {
-        bool pointOnRoad = false;
-
-        // Determine which tile the point is over
-        int tileSize = VariableManager::getTileSize();
-        sf::Vector2i pointTilePosition(
-                static_cast<int>(point.x / tileSize),
-                static_cast<int>(point.y / tileSize)
-        );
-
-        // Search neighboring tiles
-        int searchRadius = 1;
-        for (int dx = -searchRadius; dx <= searchRadius; ++dx) {
-            for (int dy = -searchRadius; dy <= searchRadius; ++dy) {
-                int x = pointTilePosition.x + dx;
-                int y = pointTilePosition.y + dy;
-
-                if (x < 0 || x >= boundaries.x || y < 0 || y >= boundaries.y)
-                    continue;
-
-                int tileID = placedTileIDs[x][y];
-                if (tileID < 0) continue;
-
-                Tile& tile = tiles[tileID];
-                const sf::ConvexShape& collisionShape = tile.collisionShape;
-
-                sf::Sprite& tileSprite = placedTileSprites[x][y];
-
-                sf::Transform combinedTransform = tileSprite.getTransform() * collisionShape.getTransform();
-
-                if (isPointInPolygon(point, collisionShape, combinedTransform)) {
-                    pointOnRoad = true;
-                    break;
-                }
-            }
-            if (pointOnRoad) break;
-        }
-
-        if (!pointOnRoad) {
+        if (!isPointOnTrack(point)) {
             allPointsOnRoad = false;
             break; // One point is off the road
         }
@@ -27,7 +27,7 @@ bool GameStateParent::getLineIntersection(sf::Vector2f p0, sf::Vector2f p1, sf::
     return false;
 }
 
-void GameStateParent::loadLevelFromCSV(const std::string &filename, Game &game) {
+void GameStateParent::loadLevelFromCSV(const std::string &filename) {
     std::cout << "[DEBUG] Level loading from file: " << filename << "\n";
 
     std::ifstream file(filename);
@@ -82,7 +82,7 @@ void GameStateParent::loadLevelFromCSV(const std::string &filename, Game &game)
                     }
 
                     sf::Sprite s;
-                    s.setTexture(tiles[texture].getTexture());
+                    tiles[texture].applyTo(s);
                     s.setScale(VariableManager::getTileSize() / s.getLocalBounds().height, VariableManager::getTileSize() / s.getLocalBounds().height);
                     s.setPosition(VariableManager::getTileSize() * x, VariableManager::getTileSize() * y);
 
@@ -121,11 +121,42 @@ GameStateParent::GameStateParent(Game &game, const std::string &levelFile) {
     placedTileIDs.clear();
     std::cout << "[DEBUG] Loading tiles from CSV\n";
     tiles = ResourceManager::getTiles();
-    loadLevelFromCSV(levelFile, game);
-    loadLevelFromCSV(levelFile, game);
+    loadLevelFromCSV(levelFile);
+    buildCollision();
     loadBackground(game);
 }
 
+GameStateParent::GameStateParent(const std::string &levelFile) {
+    std::cout << "[DEBUG] Initializing headless GameState\n";
+    placedTileSprites.clear();
+    placedTileIDs.clear();
+    tiles = ResourceManager::getTiles();
+    loadLevelFromCSV(levelFile);
+    buildCollision();
+}
+
+void GameStateParent::buildCollision() {
+    trackCollision.build(boundaries, VariableManager::getTileSize(), placedTileIDs, placedTileSprites, tiles);
+
+    distanceField.clear();
+    if (!VariableManager::getUseDistanceField() || boundaries.x <= 0 || boundaries.y <= 0) {
+        return;
+    }
+
+    float texelSize = std::max(VariableManager::getDistanceFieldTexelSize(), 0.1f);
+    std::cout << "[DEBUG] Building track distance field with " << texelSize << " px texels\n";
+    distanceField.build(getLevelSize(), texelSize, [this](const sf::Vector2f &point) {
+        return trackCollision.isPointOnTrack(point);
+    });
+}
+
+bool GameStateParent::isPointOnTrack(const sf::Vector2f &point) {
+    if (!distanceField.isEmpty()) {
+        return distanceField.isOnTrack(point);
+    }
+    return trackCollision.isPointOnTrack(point);
+}
+
 bool GameStateParent::isPointInPolygon(const sf::Vector2f &point, const sf::ConvexShape &polygon) {
     int i, j, nvert = polygon.getPointCount();
     bool c = false;
@@ -152,6 +183,13 @@ bool GameStateParent::isPointInPolygon(const sf::Vector2f& point, const sf::Conv
     return c;
 }
 
+float GameStateParent::castRay(const sf::Vector2f &origin, const sf::Vector2f &direction, float maxDistance) {
+    if (!distanceField.isEmpty()) {
+        return distanceField.castRay(origin, direction, maxDistance);
+    }
+    return trackCollision.castRay(origin, direction, maxDistance);
+}
+
 bool GameStateParent::isPauseKeyPressed(const sf::Event &event) const {
     return (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::P);
 }
@@ -0,0 +1,318 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#include "HeadlessTrainer.h"
+#include "DistributedTrainer.h"
+#include "MetricsManager.h"
+
+#include <limits>
+#include <numeric>
+#include <thread>
+
+// Peak memory of the process and what ArrayFire holds on the device, to size NETWORKS_AMOUNT
+static void printResourceUse() {
+    MetricsManager &metrics = MetricsManager::getInstance();
+    metrics.sample();
+    std::cout << "[HEADLESS] Peak memory " << metrics.getPeakMemoryUsage() << " MB, device memory "
+              << metrics.getGPUUsage() << " MB in use, " << metrics.getMinorPageFaults() << " minor page faults, "
+              << metrics.getInvoluntaryContextSwitches() << " involuntary context switches\n";
+}
+
+HeadlessTrainer::HeadlessTrainer(const std::string &levelFile, int generations, int maxStepsPerGeneration,
+                                 const std::string &savePath)
+        : levelFile(levelFile), savePath(savePath), generations(generations),
+          maxStepsPerGeneration(maxStepsPerGeneration) {}
+
+void HeadlessTrainer::setIslands(int islands, int migrationInterval, int migrants) {
+    this->islands = std::max(1, islands);
+    this->migrationInterval = migrationInterval;
+    this->migrants = std::max(0, migrants);
+}
+
+bool HeadlessTrainer::loadResources(std::vector<carData> &cars) {
+    VariableManager::loadFromJson(VariableManager::getPathToConfig());
+
+    // Only the data the simulation needs, textures are replaced by their image sizes
+    ResourceManager::setHeadless(true);
+    ResourceManager::loadTilesFromCSV(VariableManager::getPathToTileConfig());
+    ResourceManager::loadCarsFromCSV(VariableManager::getPathToCarConfig(), cars);
+
+    if (ResourceManager::getTiles().empty()) {
+        std::cerr << "[HEADLESS] No tiles could be loaded from " << VariableManager::getPathToTileConfig() << "\n";
+        return false;
+    }
+    if (cars.empty()) {
+        std::cerr << "[HEADLESS] No cars could be loaded from " << VariableManager::getPathToCarConfig() << "\n";
+        return false;
+    }
+
+    Utility::setup();
+    return true;
+}
+
+int HeadlessTrainer::run() {
+    if (!loadResources(cars)) {
+        return 1;
+    }
+
+    // The settings of a replayed run replace the config file
+    if (replaying) {
+        replay.apply();
+    } else if (seed != 0) {
+        VariableManager::setSeed(seed);
+    }
+
+    int carIndex = std::clamp(VariableManager::getSelectedCarIndex(), 0, (int)cars.size() - 1);
+    if (islands > 1) {
+        if (!manifestPath.empty() || replaying) {
+            std::cerr << "[HEADLESS] Island runs depend on the timing of the migrations and can not be replayed\n";
+            return 1;
+        }
+        return runIslands(cars[carIndex]);
+    }
+
+    AiGameState state(levelFile, cars[carIndex]);
+    RunManifest manifest;
+    manifest.begin(levelFile, generations, maxStepsPerGeneration);
+
+    std::cout << "[HEADLESS] Training on " << levelFile << " for " << generations << " generations with "
+              << VariableManager::getNetworksAmount() << " networks, seed " << RunManifest::runSeed() << "\n";
+
+    auto trainingStart = std::chrono::high_resolution_clock::now();
+    long long totalCarSteps = 0;
+
+    while (state.getCurrentGeneration() < generations) {
+        auto generationStart = std::chrono::high_resolution_clock::now();
+        long long carSteps = 0;
+        int steps = runGeneration(state, carSteps);
+
+        int generation = state.getCurrentGeneration();
+        manifest.addGeneration(generation, state.calculateScores(), steps);
+        state.nextGeneration();
+        totalCarSteps += carSteps;
+
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - generationStart;
+        std::cout << "[HEADLESS] Generation " << generation << ": best score " << state.getLastBestScore()
+                  << ", " << steps << " steps, " << (long long)(carSteps / std::max(elapsed.count(), 1e-9))
+                  << " car-steps/s\n";
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - trainingStart;
+    std::cout << "[HEADLESS] Finished " << generations << " generations in " << elapsed.count() << " s, "
+              << (long long)(totalCarSteps / std::max(elapsed.count(), 1e-9)) << " car-steps/s on average\n";
+    printResourceUse();
+
+    if (!savePath.empty()) {
+        std::cout << "[HEADLESS] Network saved: " << state.getNetwork().save(savePath, VariableManager::getAiWinners()) << "\n";
+    }
+    if (!manifestPath.empty()) {
+        std::cout << "[HEADLESS] Manifest saved: " << manifest.save(manifestPath) << "\n";
+    }
+
+    if (replaying) {
+        int mismatch = manifest.firstMismatch(replay);
+        if (mismatch >= 0) {
+            std::cerr << "[HEADLESS] Replay differs from the manifest in generation " << mismatch << "\n";
+            return 1;
+        }
+        std::cout << "[HEADLESS] Replay matches the manifest in all " << generations << " generations\n";
+    }
+    return 0;
+}
+
+int HeadlessTrainer::runGeneration(AiGameState &state, long long &carSteps) {
+    int steps = 0;
+    while (!state.isGenerationFinished()) {
+        carSteps += state.getAliveCars();
+        state.simulationStep();
+
+        steps++;
+        if (maxStepsPerGeneration > 0 && steps >= maxStepsPerGeneration) {
+            state.requestReset();
+        }
+    }
+    return steps;
+}
+
+void HeadlessTrainer::runIsland(int island, carData car, int networks, Mailbox<Genomes> &inbox,
+                                Mailbox<Genomes> &outbox, float &bestScore, std::vector<float> &bestGenome) {
+    // The islands themselves are the parallelism, every island steps on its own thread only
+    AiGameState state(levelFile, car, networks, 1, island);
+    bestScore = -std::numeric_limits<float>::infinity();
+
+    while (state.getCurrentGeneration() < generations) {
+        long long carSteps = 0;
+        int steps = runGeneration(state, carSteps);
+        int generation = state.getCurrentGeneration();
+
+        std::vector<float> scores = state.calculateScores();
+        std::vector<int> order(scores.size());
+        std::iota(order.begin(), order.end(), 0);
+        int best = std::min(std::max(migrants, 1), (int)order.size());
+        std::partial_sort(order.begin(), order.begin() + best, order.end(),
+                          [&scores](int a, int b) { return scores[a] > scores[b]; });
+
+        if (scores[order[0]] > bestScore) {
+            bestScore = scores[order[0]];
+            bestGenome = state.getNetwork().get_genome(order[0]);
+        }
+
+        // Send copies of the best networks before breeding replaces them
+        bool migrate = migrants > 0 && migrationInterval > 0 && (generation + 1) % migrationInterval == 0;
+        if (migrate) {
+            auto genomes = std::make_unique<Genomes>();
+            for (int i = 0; i < std::min(migrants, (int)order.size()); ++i) {
+                genomes->push_back(state.getNetwork().get_genome(order[i]));
+            }
+            outbox.post(std::move(genomes));
+        }
+
+        state.nextGeneration();
+
+        // Arrivals replace the last children, the elites are at the front after breeding
+        if (auto arrivals = inbox.take()) {
+            for (int i = 0; i < arrivals->size() && i < networks; ++i) {
+                state.getNetwork().set_genome(networks - 1 - i, (*arrivals)[i]);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::cout << "[HEADLESS] Island " << island << " generation " << generation << ": best score "
+                  << state.getLastBestScore() << ", " << steps << " steps" << (migrate ? ", migrated" : "") << "\n";
+    }
+}
+
+int HeadlessTrainer::runIslands(carData &car) {
+    int networks = std::max(1, VariableManager::getNetworksAmount() / islands);
+    // breed refuses to run with more winners than networks, evolution would silently stop
+    if (networks < VariableManager::getAiWinners()) {
+        std::cerr << "[HEADLESS] " << islands << " islands leave " << networks << " networks each, fewer than the "
+                  << VariableManager::getAiWinners() << " AI_WINNERS. Use fewer islands or more networks\n";
+        return 1;
+    }
+    std::cout << "[HEADLESS] Training on " << levelFile << " for " << generations << " generations with "
+              << islands << " islands of " << networks << " networks\n";
+
+    // Island i sends to island i + 1, the last one to the first
+    std::vector<std::unique_ptr<Mailbox<Genomes>>> mailboxes;
+    for (int i = 0; i < islands; ++i) {
+        mailboxes.emplace_back(std::make_unique<Mailbox<Genomes>>());
+    }
+
+    std::vector<float> bestScores(islands);
+    std::vector<std::vector<float>> bestGenomes(islands);
+
+    auto trainingStart = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < islands; ++i) {
+        threads.emplace_back(&HeadlessTrainer::runIsland, this, i, car, networks, std::ref(*mailboxes[i]),
+                             std::ref(*mailboxes[(i + 1) % islands]), std::ref(bestScores[i]), std::ref(bestGenomes[i]));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    int bestIsland = (int)(std::max_element(bestScores.begin(), bestScores.end()) - bestScores.begin());
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - trainingStart;
+    std::cout << "[HEADLESS] Finished " << generations << " generations in " << elapsed.count() << " s, best score "
+              << bestScores[bestIsland] << " on island " << bestIsland << "\n";
+    printResourceUse();
+
+    if (!savePath.empty() && !bestGenomes[bestIsland].empty()) {
+        // A population of one holding the best network found on any island
+        NeuralNetwork best(VariableManager::getAiTopology(), VariableManager::getAiActivations(), 1);
+        best.set_genome(0, bestGenomes[bestIsland]);
+        std::cout << "[HEADLESS] Network saved: " << best.save(savePath, 1) << "\n";
+    }
+    return 0;
+}
+
+int HeadlessTrainer::runFromArguments(int argc, char *argv[]) {
+    std::string levelFile;
+    std::string savePath;
+    int generations = 100;
+    int steps = 0;
+    int islands = 1;
+    int migrationInterval = 5;
+    int migrants = 1;
+    int workers = 0;
+    unsigned int seed = 0;
+    std::string manifestPath;
+    std::string replayPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--headless" && hasValue) {
+            levelFile = argv[++i];
+        } else if (arg == "--generations" && hasValue) {
+            generations = std::stoi(argv[++i]);
+        } else if (arg == "--steps" && hasValue) {
+            steps = std::stoi(argv[++i]);
+        } else if (arg == "--save" && hasValue) {
+            savePath = argv[++i];
+        } else if (arg == "--islands" && hasValue) {
+            islands = std::stoi(argv[++i]);
+        } else if (arg == "--migrate-every" && hasValue) {
+            migrationInterval = std::stoi(argv[++i]);
+        } else if (arg == "--migrants" && hasValue) {
+            migrants = std::stoi(argv[++i]);
+        } else if (arg == "--workers" && hasValue) {
+            workers = std::stoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            seed = (unsigned int)std::stoul(argv[++i]);
+        } else if (arg == "--manifest" && hasValue) {
+            manifestPath = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            replayPath = argv[++i];
+        }
+    }
+
+    // Island and worker runs depend on the timing of the migrations, nothing there could be compared
+    if ((!manifestPath.empty() || !replayPath.empty()) && (islands > 1 || workers > 0)) {
+        std::cerr << "[HEADLESS] --manifest and --replay only work with a single population,"
+                     " not with --islands or --workers\n";
+        return 1;
+    }
+
+    // A replay repeats the level, generations and step limit of the manifest
+    RunManifest replay;
+    if (!replayPath.empty()) {
+        if (!replay.load(replayPath)) {
+            return 1;
+        }
+        levelFile = replay.getLevelFile();
+        generations = replay.getGenerations();
+        steps = replay.getMaxSteps();
+    }
+
+    if (levelFile.empty()) {
+        std::cerr << "Usage: IntelliDrive --headless <level.csv> [--generations N] [--steps N] [--save path]"
+                     " [--islands N] [--migrate-every K] [--migrants M] [--workers N]"
+                     " [--seed N] [--manifest path] [--replay manifest]\n";
+        return 1;
+    }
+
+    if (workers > 0) {
+        // The workers are started from the same executable
+#ifdef __linux__
+        std::string executable = "/proc/self/exe";
+#else
+        std::string executable = argv[0];
+#endif
+        DistributedTrainer trainer(levelFile, generations, workers, steps, savePath);
+        trainer.setSeed(seed);
+        return trainer.run(executable);
+    }
+
+    HeadlessTrainer trainer(levelFile, generations, steps, savePath);
+    trainer.setIslands(islands, migrationInterval, migrants);
+    trainer.setSeed(seed);
+    trainer.setManifestPath(manifestPath);
+    if (!replayPath.empty()) {
+        trainer.setReplay(replay);
+    }
+    return trainer.run();
+}
@@ -411,7 +411,7 @@ void LevelCreator::updateTileSelectionUI(Game& game) {
         int index = (selectedIndex + i + totalTiles) % totalTiles;
         int tileID = tileIndices[index];
         sf::Sprite sprite;
-        sprite.setTexture(tiles[tileID].getTexture());
+        tiles[tileID].applyTo(sprite);
 
         // Erhöhe scaleFactor, um Tiles größer zu machen
         float scaleFactor = 1.2f;
@@ -452,7 +452,7 @@ void LevelCreator::updatePreviewTile(Game& game) {
     float snappedY = static_cast<int>(mousePos.y / VariableManager::getTileSize()) * VariableManager::getTileSize();
 
     if (selectedTile != -1) {
-        previewTile.setTexture(tiles[selectedTile].getTexture());
+        tiles[selectedTile].applyTo(previewTile);
         previewTile.setScale(VariableManager::getTileSize() / previewTile.getLocalBounds().height, VariableManager::getTileSize() / previewTile.getLocalBounds().height);
         previewTile.setPosition(snappedX, snappedY);
         previewTile.setColor(sf::Color(255, 255, 255, 128));
@@ -461,7 +461,6 @@ void LevelCreator::updatePreviewTile(Game& game) {
 
 void LevelCreator::render(Game& game) {
     game.window.clear();
-    game.window.draw(backgroundSprite);
 
     switch (currentState) {
         case EditorState::Edit:
@@ -593,37 +592,40 @@ void LevelCreator::addTileAtMouse(Game& game) {
     if (grid.x < 0 || grid.x >= boundaries.x || grid.y < 0 || grid.y >= boundaries.y) {
         return;
     }
+    // Holding the mouse over the same tile must not bake the layer again every frame
+    if (placedTileIDs[grid.x][grid.y] == selectedTile) {
+        return;
+    }
 
     float snappedX = grid.x * VariableManager::getTileSize();
     float snappedY = grid.y * VariableManager::getTileSize();
 
     sf::Sprite s;
-    s.setTexture(tiles[selectedTile].getTexture());
+    tiles[selectedTile].applyTo(s);
     s.setScale(VariableManager::getTileSize() / s.getLocalBounds().height, VariableManager::getTileSize() / s.getLocalBounds().height);
     s.setPosition(snappedX, snappedY);
 
     placedTileIDs[grid.x][grid.y] = selectedTile;
     placedTileSprites[grid.x][grid.y] = s;
+    tileLayer.invalidate();
 }
 
 void LevelCreator::removeTileAtMouse(Game& game) {
     sf::Vector2i mousePos = sf::Mouse::getPosition(game.window);
     sf::Vector2i grid(static_cast<int>(mousePos.x / VariableManager::getTileSize()), static_cast<int>(mousePos.y / VariableManager::getTileSize()));
 
-    if (grid.x < 0 || grid.x >= boundaries.x || grid.y < 0 || grid.y >= boundaries.y) {
+    if (grid.x < 0 || grid.x >= boundaries.x || grid.y < 0 || grid.y >= boundaries.y || placedTileIDs[grid.x][grid.y] == -1) {
         return;
     }
 
     placedTileIDs[grid.x][grid.y] = -1;
     placedTileSprites[grid.x][grid.y] = {};
+    tileLayer.invalidate();
 }
 
 void LevelCreator::drawPlacedTiles(Game& game) {
-    for (const auto& tileX : placedTileSprites) {
-        for (const auto& tileY : tileX) {
-            game.window.draw(tileY);
-        }
-    }
+    // Includes the background
+    tileLayer.draw(game.window, &backgroundSprite, placedTileSprites);
 }
 
 void LevelCreator::drawButtons(Game& game) {
@@ -745,6 +747,7 @@ void LevelCreator::saveLevelToCSV(const std::string& filename) {
 void LevelCreator::clearDrawing(Game& game) {
     placedTileSprites.clear();
     placedTileIDs.clear();
+    tileLayer.invalidate();
 
     game.changeState(std::make_shared<MenuState>());
 }
@@ -769,6 +772,7 @@ void LevelCreator::loadLevelFromCSV(const std::string& filename, Game& game) {
 
     placedTileIDs.clear();
     placedTileSprites.clear();
+    tileLayer.invalidate();
 
     placedTileIDs.resize(boundaries.x, std::vector<int>(boundaries.y, -1));
     placedTileSprites.resize(boundaries.x, std::vector<sf::Sprite>(boundaries.y));
@@ -806,7 +810,7 @@ void LevelCreator::loadLevelFromCSV(const std::string& filename, Game& game) {
                     float y = j * VariableManager::getTileSize();
 
                     sf::Sprite s;
-                    s.setTexture(tiles[tileID].getTexture());
+                    tiles[tileID].applyTo(s);
                     s.setScale(VariableManager::getTileSize() / s.getLocalBounds().height, VariableManager::getTileSize() / s.getLocalBounds().height);
                     s.setPosition(x, y);
 
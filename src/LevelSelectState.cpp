@@ -175,7 +175,7 @@ void LevelSelectState::loadLevelPreview(Game& game, const std::string& filename,
                     float y = std::stof(yStr) * scaleY;
 
                     sf::Sprite element;
-                    element.setTexture(tiles[textureIndex % tiles.size()].getTexture());
+                    tiles[textureIndex % tiles.size()].applyTo(element);
                     element.setPosition(preview.getPosition().x + x, preview.getPosition().y + y);
                     element.setScale(scaleX, scaleY); // Scale the sprite to fit the preview
 
@@ -4,8 +4,45 @@
 
 #include "MetricsManager.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <arrayfire.h>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+// Name and the fields after it from /proc/.../stat, the name is in parentheses and may contain spaces
+static bool readStat(const std::string &path, std::string &name, std::vector<std::string> &fields) {
+    std::ifstream file(path);
+    std::string line;
+    if (!std::getline(file, line)) return false;
+
+    size_t open = line.find('(');
+    size_t close = line.rfind(')');
+    if (open == std::string::npos || close == std::string::npos || close < open) return false;
+    name = line.substr(open + 1, close - open - 1);
+
+    std::istringstream stream(line.substr(close + 1));
+    fields.clear();
+    for (std::string field; stream >> field;) {
+        fields.push_back(field);
+    }
+    // fields[0] is field 3 of the stat file, utime and stime are 14 and 15
+    return fields.size() > 12;
+}
+
+static unsigned long long statTicks(const std::vector<std::string> &fields) {
+    return std::stoull(fields[11]) + std::stoull(fields[12]);
+}
+#endif
+
 MetricsManager::MetricsManager() {
     lastFrame = std::chrono::high_resolution_clock::now();
+    lastSample = lastFrame;
     fps = 0.f;
     frameTime = 0.f;
 }
@@ -24,6 +61,76 @@ void MetricsManager::frameEnd() {
     std::chrono::duration<float> diff = now - lastFrame;
     frameTime = diff.count() * 1000.0f;
     fps = 1.0f / diff.count();
+
+    std::chrono::duration<float> sinceSample = now - lastSample;
+    if (sinceSample.count() >= sampleInterval) {
+        sample();
+    }
+}
+
+void MetricsManager::sample() {
+    auto now = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<float> elapsed = now - lastSample;
+    lastSample = now;
+
+#ifdef __linux__
+    float tickSeconds = 1.0f / (float)sysconf(_SC_CLK_TCK);
+    float seconds = std::max(elapsed.count(), 1e-3f);
+
+    std::string name;
+    std::vector<std::string> fields;
+    if (readStat("/proc/self/stat", name, fields)) {
+        unsigned long long ticks = statTicks(fields);
+        if (sampled) {
+            cpuUsage = (float)(ticks - lastProcessTicks) * tickSeconds / seconds * 100.0f;
+        }
+        lastProcessTicks = ticks;
+    }
+
+    // Second field of statm is the resident size in pages
+    std::ifstream statm("/proc/self/statm");
+    long sizePages = 0, residentPages = 0;
+    if (statm >> sizePages >> residentPages) {
+        residentMB = (float)residentPages * (float)sysconf(_SC_PAGESIZE) / (1024.0f * 1024.0f);
+    }
+
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        minorFaults = usage.ru_minflt;
+        majorFaults = usage.ru_majflt;
+        voluntarySwitches = usage.ru_nvcsw;
+        involuntarySwitches = usage.ru_nivcsw;
+        peakResidentMB = (float)usage.ru_maxrss / 1024.0f; // Reported in KB
+    }
+
+    // One stat file per thread, the usage is the difference to the previous sample of the same thread
+    std::vector<ThreadUsage> current;
+    if (DIR *tasks = opendir("/proc/self/task")) {
+        while (dirent *entry = readdir(tasks)) {
+            if (entry->d_name[0] == '.') continue;
+            if (!readStat(std::string("/proc/self/task/") + entry->d_name + "/stat", name, fields)) continue;
+
+            ThreadUsage thread;
+            thread.id = std::atoi(entry->d_name);
+            thread.name = name;
+            thread.ticks = statTicks(fields);
+            auto previous = std::find_if(threads.begin(), threads.end(),
+                                         [&thread](const ThreadUsage &t) { return t.id == thread.id; });
+            if (previous != threads.end()) {
+                thread.cpu = (float)(thread.ticks - previous->ticks) * tickSeconds / seconds * 100.0f;
+            }
+            current.push_back(thread);
+        }
+        closedir(tasks);
+    }
+    std::sort(current.begin(), current.end(),
+              [](const ThreadUsage &a, const ThreadUsage &b) { return a.cpu > b.cpu; });
+    threads = current;
+#endif
+
+    size_t allocBuffers = 0, lockBuffers = 0;
+    af::deviceMemInfo(&deviceAllocated, &allocBuffers, &deviceLocked, &lockBuffers);
+    sampled = true;
 }
 
 float MetricsManager::getFPS() const {
@@ -35,13 +142,36 @@ float MetricsManager::getFrameTime() const {
 }
 
 float MetricsManager::getCPUUsage() const {
-    return 0.0f;
+    return cpuUsage;
 }
 
 float MetricsManager::getGPUUsage() const {
-    return 0.0f;
+    return (float)deviceLocked / (1024.0f * 1024.0f);
 }
 
 float MetricsManager::getMemoryUsage() const {
-    return 0.0f;
-}
\ No newline at end of file
+    return residentMB;
+}
+
+std::string MetricsManager::report(bool advanced) const {
+    std::ostringstream stream;
+    stream.setf(std::ios::fixed);
+    stream.precision(1);
+    stream << "FPS: " << fps << " (" << frameTime << " ms)\n"
+           << "CPU: " << cpuUsage << " %\n"
+           << "Memory: " << residentMB << " MB\n"
+           << "Device memory: " << getGPUUsage() << " MB";
+
+    if (advanced) {
+        stream << " of " << (float)deviceAllocated / (1024.0f * 1024.0f) << " MB allocated\n"
+               << "Peak memory: " << peakResidentMB << " MB\n"
+               << "Page faults: " << minorFaults << " minor, " << majorFaults << " major\n"
+               << "Context switches: " << voluntarySwitches << " voluntary, " << involuntarySwitches << " involuntary\n"
+               << "Threads: " << threads.size();
+        // The busiest ones, the list is sorted by usage
+        for (size_t i = 0; i < threads.size() && i < 8; ++i) {
+            stream << "\n  " << threads[i].id << " " << threads[i].name << ": " << threads[i].cpu << " %";
+        }
+    }
+    return stream.str();
+}
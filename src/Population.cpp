@@ -0,0 +1,487 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#include "Population.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <iostream>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define POPULATION_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POPULATION_SIMD_SSE2
+#endif
+
+namespace {
+#if defined(POPULATION_SIMD_AVX2)
+    struct SimdOps {
+        using F = __m256;
+        using I = __m256i;
+        static constexpr int width = 8;
+
+        static F load(const float *p) { return _mm256_loadu_ps(p); }
+        static void store(float *p, F a) { _mm256_storeu_ps(p, a); }
+        static F set1(float a) { return _mm256_set1_ps(a); }
+        static F add(F a, F b) { return _mm256_add_ps(a, b); }
+        static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+        static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+        static F div(F a, F b) { return _mm256_div_ps(a, b); }
+        static F sqrt(F a) { return _mm256_sqrt_ps(a); }
+        static F gt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static F lt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static F ge(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        static F bitAnd(F a, F b) { return _mm256_and_ps(a, b); }
+        static F bitOr(F a, F b) { return _mm256_or_ps(a, b); }
+        static F select(F mask, F a, F b) { return _mm256_blendv_ps(b, a, mask); }
+        static F abs(F a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+        static I roundToInt(F a) { return _mm256_cvtps_epi32(a); }
+        static F toFloat(I a) { return _mm256_cvtepi32_ps(a); }
+        static F quadrantIs(I j, int q) {
+            return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(3)), _mm256_set1_epi32(q)));
+        }
+        static F aliveMask(const std::uint8_t *p) {
+            __m256i a = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+            return _mm256_castsi256_ps(_mm256_cmpgt_epi32(a, _mm256_setzero_si256()));
+        }
+    };
+#elif defined(POPULATION_SIMD_SSE2)
+    struct SimdOps {
+        using F = __m128;
+        using I = __m128i;
+        static constexpr int width = 4;
+
+        static F load(const float *p) { return _mm_loadu_ps(p); }
+        static void store(float *p, F a) { _mm_storeu_ps(p, a); }
+        static F set1(float a) { return _mm_set1_ps(a); }
+        static F add(F a, F b) { return _mm_add_ps(a, b); }
+        static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+        static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+        static F div(F a, F b) { return _mm_div_ps(a, b); }
+        static F sqrt(F a) { return _mm_sqrt_ps(a); }
+        static F gt(F a, F b) { return _mm_cmpgt_ps(a, b); }
+        static F lt(F a, F b) { return _mm_cmplt_ps(a, b); }
+        static F ge(F a, F b) { return _mm_cmpge_ps(a, b); }
+        static F bitAnd(F a, F b) { return _mm_and_ps(a, b); }
+        static F bitOr(F a, F b) { return _mm_or_ps(a, b); }
+        static F select(F mask, F a, F b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+        static F abs(F a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+        static I roundToInt(F a) { return _mm_cvtps_epi32(a); }
+        static F toFloat(I a) { return _mm_cvtepi32_ps(a); }
+        static F quadrantIs(I j, int q) {
+            return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(3)), _mm_set1_epi32(q)));
+        }
+        static F aliveMask(const std::uint8_t *p) {
+            std::int32_t bits;
+            std::memcpy(&bits, p, sizeof(bits));
+            __m128i a = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bits), _mm_setzero_si128()), _mm_setzero_si128());
+            return _mm_castsi128_ps(_mm_cmpgt_epi32(a, _mm_setzero_si128()));
+        }
+    };
+#endif
+
+#if defined(POPULATION_SIMD_AVX2) || defined(POPULATION_SIMD_SSE2)
+    // sin and cos of x in radians. Reduction by pi/2 in three parts, minimax polynomials on [-pi/4, pi/4].
+    // Accurate to a few ulp for the angles the cars use.
+    template<class V>
+    inline void sinCos(typename V::F x, typename V::F &sinOut, typename V::F &cosOut) {
+        using F = typename V::F;
+        typename V::I j = V::roundToInt(V::mul(x, V::set1(0.636619772367581343f)));
+        F jf = V::toFloat(j);
+        F r = V::sub(x, V::mul(jf, V::set1(1.5703125f)));
+        r = V::sub(r, V::mul(jf, V::set1(4.837512969970703125e-4f)));
+        r = V::sub(r, V::mul(jf, V::set1(7.54978995489188216e-8f)));
+
+        F r2 = V::mul(r, r);
+        F s = V::add(V::set1(8.3321608736e-3f), V::mul(r2, V::set1(-1.9515295891e-4f)));
+        s = V::add(V::set1(-1.6666654611e-1f), V::mul(r2, s));
+        s = V::add(r, V::mul(V::mul(r2, r), s));
+
+        F c = V::add(V::set1(-1.388731625493765e-3f), V::mul(r2, V::set1(2.443315711809948e-5f)));
+        c = V::add(V::set1(4.166664568298827e-2f), V::mul(r2, c));
+        c = V::add(V::sub(V::set1(1.0f), V::mul(r2, V::set1(0.5f))), V::mul(V::mul(r2, r2), c));
+
+        // Quadrant 0: (s, c), 1: (c, -s), 2: (-s, -c), 3: (-c, s)
+        F zero = V::set1(0.0f);
+        F q1 = V::quadrantIs(j, 1);
+        F q2 = V::quadrantIs(j, 2);
+        F q3 = V::quadrantIs(j, 3);
+        sinOut = V::select(q1, c, V::select(q2, V::sub(zero, s), V::select(q3, V::sub(zero, c), s)));
+        cosOut = V::select(q1, V::sub(zero, s), V::select(q2, V::sub(zero, c), V::select(q3, s, c)));
+    }
+#endif
+}
+
+void Population::initialize(int count, int rayCount, Car &templateCar) {
+    this->count = count;
+    this->rayCount = rayCount;
+
+    accelerationConstant = templateCar.getAccelerationConstant();
+    angularAccelerationConstant = templateCar.getAngularAccelerationConstant();
+    maxSpeed = templateCar.getMaxSpeed();
+    frictionCoefficient = templateCar.getFrictionCoefficient();
+
+    // The sprite origin is its center, so the corners are +-half the scaled size
+    const sf::Sprite &sprite = templateCar.getCarSprite();
+    sf::FloatRect bounds = sprite.getLocalBounds();
+    halfExtents = {bounds.width / 2.0f * sprite.getScale().x, bounds.height / 2.0f * sprite.getScale().y};
+
+    positionX.assign(count, 0.0f);
+    positionY.assign(count, 0.0f);
+    velocityX.assign(count, 0.0f);
+    velocityY.assign(count, 0.0f);
+    rotation.assign(count, 0.0f);
+    angularVelocity.assign(count, 0.0f);
+    acceleration.assign(count, 0.0f);
+    angularAcceleration.assign(count, 0.0f);
+    distanceRotated.assign(count, 0.0f);
+    distanceMovedBackwards.assign(count, 0.0f);
+    rayDistances.assign(static_cast<size_t>(count) * rayCount, 0.0f);
+    rayHits.assign(static_cast<size_t>(count) * rayCount, sf::Vector2f());
+    nextCheckpoint.assign(count, 0);
+    alive.assign(count, 1);
+    points.assign(count, 0.0f);
+    timeSinceCheckpoint.assign(count, 0.0f);
+    checkpointsReached.assign(count, 0);
+    activeCars.resize(count);
+    std::iota(activeCars.begin(), activeCars.end(), 0);
+}
+
+void Population::spawn(const sf::Vector2f &position, float rotationAngle) {
+    std::fill(positionX.begin(), positionX.end(), position.x);
+    std::fill(positionY.begin(), positionY.end(), position.y);
+    std::fill(rotation.begin(), rotation.end(), rotationAngle);
+
+    std::fill(velocityX.begin(), velocityX.end(), 0.0f);
+    std::fill(velocityY.begin(), velocityY.end(), 0.0f);
+    std::fill(angularVelocity.begin(), angularVelocity.end(), 0.0f);
+    std::fill(acceleration.begin(), acceleration.end(), 0.0f);
+    std::fill(angularAcceleration.begin(), angularAcceleration.end(), 0.0f);
+    std::fill(distanceRotated.begin(), distanceRotated.end(), 0.0f);
+    std::fill(distanceMovedBackwards.begin(), distanceMovedBackwards.end(), 0.0f);
+    std::fill(rayDistances.begin(), rayDistances.end(), 0.0f);
+    std::fill(rayHits.begin(), rayHits.end(), position);
+    std::fill(nextCheckpoint.begin(), nextCheckpoint.end(), 0);
+    std::fill(alive.begin(), alive.end(), 1);
+    std::fill(points.begin(), points.end(), 0.0f);
+    std::fill(timeSinceCheckpoint.begin(), timeSinceCheckpoint.end(), 0.0f);
+    std::fill(checkpointsReached.begin(), checkpointsReached.end(), 0);
+    activeCars.resize(count);
+    std::iota(activeCars.begin(), activeCars.end(), 0);
+}
+
+void Population::update(int i, float dt) {
+    integrate(lanes(), i, dt);
+}
+
+void Population::updateBatch(float dt, int begin, int end) {
+    integrate(lanes(), dt, begin, end);
+}
+
+void Population::updateActive(float dt, int begin, int end) {
+    // The cars are gathered into blocks so the vectorized physics runs on contiguous memory
+    static constexpr int block = 64;
+    static constexpr float *Lanes::*fields[] = {
+            &Lanes::positionX, &Lanes::positionY, &Lanes::velocityX, &Lanes::velocityY, &Lanes::rotation,
+            &Lanes::angularVelocity, &Lanes::acceleration, &Lanes::angularAcceleration, &Lanes::distanceRotated,
+            &Lanes::distanceMovedBackwards};
+    static constexpr int fieldCount = sizeof(fields) / sizeof(fields[0]);
+
+    float storage[fieldCount][block];
+    std::uint8_t aliveBlock[block];
+
+    Lanes source = lanes();
+    Lanes gathered = source;
+    for (int k = 0; k < fieldCount; ++k) gathered.*fields[k] = storage[k];
+    gathered.alive = aliveBlock;
+
+    for (int first = begin; first < end; first += block) {
+        int n = std::min(block, end - first);
+        const int *indices = &activeCars[first];
+
+        for (int k = 0; k < fieldCount; ++k) {
+            for (int j = 0; j < n; ++j) storage[k][j] = (source.*fields[k])[indices[j]];
+        }
+        for (int j = 0; j < n; ++j) aliveBlock[j] = source.alive[indices[j]];
+
+        integrate(gathered, dt, 0, n);
+
+        for (int k = 0; k < fieldCount; ++k) {
+            for (int j = 0; j < n; ++j) (source.*fields[k])[indices[j]] = storage[k][j];
+        }
+    }
+}
+
+void Population::compactActive() {
+    activeCars.erase(std::remove_if(activeCars.begin(), activeCars.end(), [this](int i) { return !alive[i]; }),
+                     activeCars.end());
+}
+
+Population::Lanes Population::lanes() {
+    return {positionX.data(), positionY.data(), velocityX.data(), velocityY.data(), rotation.data(),
+            angularVelocity.data(), acceleration.data(), angularAcceleration.data(), distanceRotated.data(),
+            distanceMovedBackwards.data(), alive.data()};
+}
+
+void Population::integrate(const Lanes &s, int i, float dt) const {
+    // Calculating the current angle in rad
+    float radian_angle = s.rotation[i] * (PI / 180.0f);
+    float forwardX = sinf(radian_angle);
+    float forwardY = -cosf(radian_angle);
+
+    // Velocity calculation based on acceleration and dt
+    float vx = s.velocityX[i] + forwardX * s.acceleration[i] * dt;
+    float vy = s.velocityY[i] + forwardY * s.acceleration[i] * dt;
+
+    // Velocity reduction by friction
+    vx -= vx * frictionCoefficient * dt;
+    vy -= vy * frictionCoefficient * dt;
+
+    // Applying speed boundaries to the velocity
+    float speed = std::sqrt(vx * vx + vy * vy);
+    if (speed > maxSpeed) {
+        vx = (vx / speed) * maxSpeed;
+        vy = (vy / speed) * maxSpeed;
+    }
+
+    s.positionX[i] += vx * dt;
+    s.positionY[i] += vy * dt;
+    s.velocityX[i] = vx;
+    s.velocityY[i] = vy;
+
+    // Detection if car moves forward or backwards
+    float forwardFactor = vx * forwardX + vy * forwardY;
+    if (forwardFactor < 0.0f) {
+        s.distanceMovedBackwards[i] += -forwardFactor * dt;
+    }
+
+    float angular_velocity = s.angularVelocity[i] + s.angularAcceleration[i] * speed * VariableManager::getRotationalSpeedMultiplier() * dt;
+    float angular_velocity_new = angular_velocity * VariableManager::getAngularDampingMultiplier();
+    if (!(angular_velocity > 0 && angular_velocity_new < 0 || angular_velocity < 0 && angular_velocity_new > 0)) {
+        angular_velocity = angular_velocity_new;
+    }
+    s.angularVelocity[i] = angular_velocity;
+
+    float angle = s.rotation[i] + angular_velocity * dt;
+    s.distanceRotated[i] += std::abs(angular_velocity * dt);
+
+    // Angle should be between 0 and 360°
+    if (angle >= 360.0f) {
+        angle -= 360.0f;
+    } else if (angle < 0.0f) {
+        angle += 360.0f;
+    }
+    s.rotation[i] = angle;
+}
+
+void Population::integrate(const Lanes &s, float dt, int begin, int end) const {
+    int i = begin;
+
+#if defined(POPULATION_SIMD_AVX2) || defined(POPULATION_SIMD_SSE2)
+    using V = SimdOps;
+    using F = V::F;
+
+    const F vDt = V::set1(dt);
+    const F vZero = V::set1(0.0f);
+    const F vFriction = V::set1(frictionCoefficient * dt);
+    const F vMaxSpeed = V::set1(maxSpeed);
+    const F vDegToRad = V::set1(PI / 180.0f);
+    const F vRotational = V::set1(VariableManager::getRotationalSpeedMultiplier());
+    const F vDamping = V::set1(VariableManager::getAngularDampingMultiplier());
+    const F v360 = V::set1(360.0f);
+
+    for (; i + V::width <= end; i += V::width) {
+        F alive = V::aliveMask(s.alive + i);
+
+        F forwardX, forwardY;
+        sinCos<V>(V::mul(V::load(s.rotation + i), vDegToRad), forwardX, forwardY);
+        forwardY = V::sub(vZero, forwardY);
+
+        // Velocity from acceleration, then friction
+        F accelerationDt = V::mul(V::load(s.acceleration + i), vDt);
+        F vx = V::add(V::load(s.velocityX + i), V::mul(forwardX, accelerationDt));
+        F vy = V::add(V::load(s.velocityY + i), V::mul(forwardY, accelerationDt));
+        vx = V::sub(vx, V::mul(vx, vFriction));
+        vy = V::sub(vy, V::mul(vy, vFriction));
+
+        // Speed clamp
+        F speed = V::sqrt(V::add(V::mul(vx, vx), V::mul(vy, vy)));
+        F tooFast = V::gt(speed, vMaxSpeed);
+        vx = V::select(tooFast, V::mul(V::div(vx, speed), vMaxSpeed), vx);
+        vy = V::select(tooFast, V::mul(V::div(vy, speed), vMaxSpeed), vy);
+
+        F px = V::add(V::load(s.positionX + i), V::mul(vx, vDt));
+        F py = V::add(V::load(s.positionY + i), V::mul(vy, vDt));
+
+        // Backwards movement
+        F forwardFactor = V::add(V::mul(vx, forwardX), V::mul(vy, forwardY));
+        F backwards = V::bitAnd(V::lt(forwardFactor, vZero), V::mul(V::sub(vZero, forwardFactor), vDt));
+        F movedBackwards = V::add(V::load(s.distanceMovedBackwards + i), backwards);
+
+        // Angular velocity with damping, the damping is skipped when it would flip the sign
+        F angularVelocity = V::add(V::load(s.angularVelocity + i),
+                                   V::mul(V::mul(V::mul(V::load(s.angularAcceleration + i), speed), vRotational), vDt));
+        F damped = V::mul(angularVelocity, vDamping);
+        F flips = V::bitOr(V::bitAnd(V::gt(angularVelocity, vZero), V::lt(damped, vZero)),
+                           V::bitAnd(V::lt(angularVelocity, vZero), V::gt(damped, vZero)));
+        angularVelocity = V::select(flips, angularVelocity, damped);
+
+        F angularStep = V::mul(angularVelocity, vDt);
+        F angle = V::add(V::load(s.rotation + i), angularStep);
+        F rotated = V::add(V::load(s.distanceRotated + i), V::abs(angularStep));
+
+        // Angle between 0 and 360°
+        F wrapped = V::select(V::ge(angle, v360), V::sub(angle, v360), angle);
+        angle = V::select(V::lt(angle, vZero), V::add(angle, v360), wrapped);
+
+        // Dead cars keep their state
+        V::store(s.positionX + i, V::select(alive, px, V::load(s.positionX + i)));
+        V::store(s.positionY + i, V::select(alive, py, V::load(s.positionY + i)));
+        V::store(s.velocityX + i, V::select(alive, vx, V::load(s.velocityX + i)));
+        V::store(s.velocityY + i, V::select(alive, vy, V::load(s.velocityY + i)));
+        V::store(s.distanceMovedBackwards + i, V::select(alive, movedBackwards, V::load(s.distanceMovedBackwards + i)));
+        V::store(s.angularVelocity + i, V::select(alive, angularVelocity, V::load(s.angularVelocity + i)));
+        V::store(s.rotation + i, V::select(alive, angle, V::load(s.rotation + i)));
+        V::store(s.distanceRotated + i, V::select(alive, rotated, V::load(s.distanceRotated + i)));
+    }
+#endif
+
+    // Remaining cars, or all of them without SIMD
+    for (; i < end; ++i) {
+        if (s.alive[i]) integrate(s, i, dt);
+    }
+}
+
+const char *Population::vectorPath() {
+#if defined(POPULATION_SIMD_AVX2)
+    return "avx2";
+#elif defined(POPULATION_SIMD_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+bool Population::verifyBatchUpdate(int count, int steps, float tolerance) {
+    carData data;
+    data.carTextureSize = {100, 200};
+    data.MaxSpeed = 5.0f;
+    data.Handling = 5.0f;
+    data.Acceleration = 5.0f;
+
+    Car car;
+    car.applyData(data);
+
+    Population scalar;
+    scalar.initialize(count, 0, car);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (int i = 0; i < count; ++i) {
+        scalar.positionX[i] = 1000.0f * unit(rng);
+        scalar.positionY[i] = 1000.0f * unit(rng);
+        scalar.velocityX[i] = scalar.maxSpeed * unit(rng);
+        scalar.velocityY[i] = scalar.maxSpeed * unit(rng);
+        scalar.rotation[i] = 180.0f + 180.0f * unit(rng);
+        scalar.angularVelocity[i] = 50.0f * unit(rng);
+        scalar.alive[i] = (i % 7 != 0);
+    }
+
+    // The reference are real cars, so a mistake shared by all ports of the physics still shows up
+    std::vector<Car> cars(count, car);
+    for (int i = 0; i < count; ++i) {
+        cars[i].setCurrentPosition({scalar.positionX[i], scalar.positionY[i]});
+        cars[i].setVelocity({scalar.velocityX[i], scalar.velocityY[i]});
+        cars[i].setRotationAngle(scalar.rotation[i]);
+        cars[i].setAngularVelocity(scalar.angularVelocity[i]);
+    }
+
+    float maxError = 0.0f;
+    auto compare = [&maxError](float expected, float actual, bool angle) {
+        float error = std::abs(expected - actual) / std::max(1.0f, std::abs(expected));
+        // 0 and 360 degrees are the same rotation
+        if (angle) {
+            error = std::min(error, std::abs(std::abs(expected - actual) - 360.0f) / 360.0f);
+        }
+        maxError = std::max(maxError, error);
+    };
+
+    for (int step = 0; step < steps; ++step) {
+        // Fresh random inputs each step
+        for (int i = 0; i < count; ++i) {
+            scalar.acceleration[i] = unit(rng) > 0.0f ? scalar.accelerationConstant : -scalar.accelerationConstant;
+            scalar.angularAcceleration[i] = unit(rng) > 0.0f ? scalar.angularAccelerationConstant : -scalar.angularAccelerationConstant;
+        }
+        Population batch = scalar;
+        Population gathered = scalar;
+        gathered.compactActive();
+
+        float dt = 1.0f / 60.0f;
+        for (int i = 0; i < count; ++i) {
+            if (!scalar.alive[i]) continue;
+            cars[i].setAcceleration(scalar.acceleration[i]);
+            cars[i].setAngularAcceleration(scalar.angularAcceleration[i]);
+            cars[i].update(dt);
+            scalar.update(i, dt);
+        }
+        batch.updateBatch(dt);
+        gathered.updateActive(dt, 0, gathered.getActiveCount());
+
+        for (const Population *other : {&scalar, &batch, &gathered}) {
+            for (int i = 0; i < count; ++i) {
+                Car &reference = cars[i];
+                compare(reference.getCurrentPosition().x, other->positionX[i], false);
+                compare(reference.getCurrentPosition().y, other->positionY[i], false);
+                compare(reference.getVelocity().x, other->velocityX[i], false);
+                compare(reference.getVelocity().y, other->velocityY[i], false);
+                compare(reference.getRotationAngle(), other->rotation[i], true);
+                compare(reference.getAngularVelocity(), other->angularVelocity[i], false);
+                compare(reference.getDistanceRotated(), other->distanceRotated[i], false);
+                compare(reference.getDistanceMovedBackwards(), other->distanceMovedBackwards[i], false);
+            }
+        }
+
+        // Every path continues from the reference, so the errors do not add up over the steps
+        for (int i = 0; i < count; ++i) {
+            scalar.positionX[i] = cars[i].getCurrentPosition().x;
+            scalar.positionY[i] = cars[i].getCurrentPosition().y;
+            scalar.velocityX[i] = cars[i].getVelocity().x;
+            scalar.velocityY[i] = cars[i].getVelocity().y;
+            scalar.rotation[i] = cars[i].getRotationAngle();
+            scalar.angularVelocity[i] = cars[i].getAngularVelocity();
+            scalar.distanceRotated[i] = cars[i].getDistanceRotated();
+            scalar.distanceMovedBackwards[i] = cars[i].getDistanceMovedBackwards();
+        }
+    }
+
+    bool passed = maxError <= tolerance;
+    std::cout << "[DEBUG] Batch physics " << (passed ? "matches" : "differs from") << " Car::update, max relative error "
+              << maxError << " over " << count << " cars and " << steps << " steps\n";
+    return passed;
+}
+
+void Population::getCorners(int i, sf::Vector2f corners[4]) const {
+    // Same result as transforming the sprite's local bounds with its transform
+    float radian_angle = rotation[i] * (PI / 180.0f);
+    float c = cosf(radian_angle);
+    float s = sinf(radian_angle);
+
+    const float signX[4] = {-1.0f, 1.0f, 1.0f, -1.0f};
+    const float signY[4] = {-1.0f, -1.0f, 1.0f, 1.0f};
+    for (int k = 0; k < 4; ++k) {
+        float x = signX[k] * halfExtents.x;
+        float y = signY[k] * halfExtents.y;
+        corners[k] = {positionX[i] + c * x - s * y, positionY[i] + s * x + c * y};
+    }
+}
+
+void Population::applyToSprite(int i, sf::Sprite &sprite) const {
+    sprite.setPosition(positionX[i], positionY[i]);
+    sprite.setRotation(rotation[i]);
+}
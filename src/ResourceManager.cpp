@@ -5,9 +5,12 @@
 #include "../include/ResourceManager.h"
 
 // Definition der statischen Variablen
+bool ResourceManager::headless = false;
 std::unordered_map<std::string, sf::Font> ResourceManager::fonts;
 std::unordered_map<std::string, sf::Texture> ResourceManager::textures;
+std::unordered_map<std::string, sf::Vector2u> ResourceManager::textureSizes;
 std::vector<Tile> ResourceManager::tiles;
+TileAtlas ResourceManager::tileAtlas;
 
 
 void ResourceManager::loadAllKnownResources() {
@@ -51,8 +54,20 @@ sf::Font& ResourceManager::getFont(const std::string& name) {
 }
 
 bool ResourceManager::loadTexture(const std::string &name, const std::string &filename) {
+    if (headless) {
+        sf::Image image;
+        if (!image.loadFromFile(filename)) {
+            std::cerr << "Error loading image: " << filename << std::endl;
+            return false;
+        }
+        textures[name] = sf::Texture();
+        textureSizes[name] = image.getSize();
+        return true;
+    }
+
     sf::Texture texture;
     if (texture.loadFromFile(filename)) {
+        textureSizes[name] = texture.getSize();
         textures[name] = std::move(texture);
         return true;
     } else {
@@ -79,6 +94,15 @@ sf::Texture& ResourceManager::getTexture(const std::string& name) {
     }
 }
 
+sf::Vector2u ResourceManager::getTextureSize(const std::string& name) {
+    auto it = textureSizes.find(name);
+    if (it != textureSizes.end()) {
+        return it->second;
+    } else {
+        throw std::runtime_error("Texture not found: " + name);
+    }
+}
+
 void ResourceManager::loadTilesFromCSV(const std::string& filename) {
     std::ifstream file(filename);
     tiles.clear();
@@ -87,7 +111,8 @@ void ResourceManager::loadTilesFromCSV(const std::string& filename) {
         return;
     }
 
-    tiles.clear();
+    std::vector<std::string> paths;
+    std::vector<std::vector<sf::Vector2f>> polygons;
 
     std::string line;
     while (std::getline(file, line)) {
@@ -95,12 +120,11 @@ void ResourceManager::loadTilesFromCSV(const std::string& filename) {
         std::string texturePath;
         std::getline(ss, texturePath, ',');
 
-        Tile tile(texturePath);
-
         size_t polygonSize;
         ss >> polygonSize;
         ss.ignore(1, ',');
 
+        std::vector<sf::Vector2f> polygon;
         for (size_t i = 0; i < polygonSize; ++i) {
             float x, y;
             ss >> x;
@@ -110,17 +134,113 @@ void ResourceManager::loadTilesFromCSV(const std::string& filename) {
                 ss.ignore(1, ',');
             }
 
-            tile.addCollisionPoint(sf::Vector2f(x, y));
+            polygon.emplace_back(x, y);
         }
 
-        tiles.push_back(tile);
+        paths.push_back(texturePath);
+        polygons.push_back(polygon);
     }
 
     file.close();
+
+    // All tile images go into one atlas, the cache saves decoding every image on the next start
+    std::string cache = VariableManager::getTileAtlasCache();
+    if (cache.empty() || !tileAtlas.loadCache(cache, paths)) {
+        std::vector<sf::Image> images(paths.size());
+        for (size_t i = 0; i < paths.size(); ++i) {
+            if (!images[i].loadFromFile(paths[i])) {
+                std::cerr << "Error loading image from " << paths[i] << std::endl;
+            }
+        }
+        tileAtlas.pack(images);
+        if (!cache.empty()) {
+            tileAtlas.saveCache(cache, paths);
+        }
+    }
+    if (!headless) {
+        tileAtlas.createTexture();
+    }
+
+    for (size_t i = 0; i < paths.size(); ++i) {
+        Tile tile(paths[i], tileAtlas.getTexture(), tileAtlas.getRect((int)i));
+        for (const auto &point : polygons[i]) {
+            tile.addCollisionPoint(point);
+        }
+        tiles.push_back(tile);
+    }
+
     std::cout << "Tiles loaded from " << filename << std::endl;
     return;
 }
 
+void ResourceManager::loadCarsFromCSV(const std::string& filename, std::vector<carData>& cars) {
+    std::ifstream inputFile(filename);
+    if (!inputFile.is_open()) {
+        std::cerr << "ERROR: Error opening file!" << "\n";
+        return;
+    }
+
+    std::string line;
+    int row = 0;
+
+    while (getline(inputFile, line)) {
+        if (row != 0) {
+            carData data;
+            parseCarDataLine(line, data);
+            cars.emplace_back(data);
+        }
+        row++;
+    }
+    inputFile.close();
+}
+
+void ResourceManager::parseCarDataLine(const std::string& line, carData& data) {
+    std::stringstream ss(line);
+    std::string token;
+    int entry = 0;
+
+    while (getline(ss, token, ',')) {
+        if (!token.empty()) {
+            switch (entry) {
+            case 0:
+                data.name = token;
+                break;
+            case 1:
+                loadTexture("CarTexture_" + data.name, token);
+                data.carTexture = getTexture("CarTexture_" + data.name);
+                data.carTextureSize = getTextureSize("CarTexture_" + data.name);
+                break;
+            case 2:
+                data.MaxSpeed = std::stof(token);
+                break;
+            case 3:
+                data.Handling = std::stof(token);
+                break;
+            case 4:
+                data.Acceleration = std::stof(token);
+                break;
+            case 5:
+                data.weight = std::stof(token);
+                break;
+            case 6:
+                data.power = std::stof(token);
+                break;
+            case 7:
+                data.torque = std::stof(token);
+                break;
+            case 8:
+                data.driveType = token;
+                break;
+            case 9:
+                loadTexture("LogoTexture_" + data.name, token);
+                data.logoTexture = getTexture("LogoTexture_" + data.name);
+                break;
+            }
+        }
+        entry++;
+    }
+}
+
 bool ResourceManager::textureExists(const std::string& textureKey) {
     return textures.find(textureKey) != textures.end();
 }
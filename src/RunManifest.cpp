@@ -0,0 +1,121 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#include "RunManifest.h"
+#include "VariableManager.h"
+#include "Population.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+unsigned int RunManifest::runSeed() {
+    if (VariableManager::getSeed() != 0) {
+        return VariableManager::getSeed();
+    }
+    // Drawn once, so every island and the manifest agree on it
+    static const unsigned int drawn = std::max(1u, std::random_device{}());
+    return drawn;
+}
+
+unsigned long long RunManifest::deriveSeed(unsigned int seed, int island, Stream stream) {
+    // splitmix64 of the combined inputs
+    unsigned long long z = ((unsigned long long)seed << 32) ^ ((unsigned long long)island << 8) ^ (unsigned long long)stream;
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+std::string RunManifest::fitnessHash(const std::vector<float> &fitness) {
+    unsigned long long hash = 0xCBF29CE484222325ull;
+    for (float value : fitness) {
+        unsigned int bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (bits >> (i * 8)) & 0xFF;
+            hash *= 0x100000001B3ull;
+        }
+    }
+
+    std::ostringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return stream.str();
+}
+
+void RunManifest::begin(const std::string &levelFile, int generations, int maxSteps) {
+    data = nlohmann::json();
+    data["level"] = levelFile;
+    data["generations"] = generations;
+    data["max_steps"] = maxSteps;
+    data["seed"] = runSeed();
+    data["timestep"] = VariableManager::getSimulationTimestep();
+    data["config"] = VariableManager::toJson();
+
+    // Results are only expected to repeat with the same build
+#if defined(_MSC_VER)
+    data["build"]["compiler"] = "msvc " + std::to_string(_MSC_VER);
+#elif defined(__VERSION__)
+    data["build"]["compiler"] = __VERSION__;
+#endif
+    data["build"]["vector_path"] = Population::vectorPath();
+    data["build"]["cpu_inference"] = VariableManager::getUseCpuInference();
+    data["generation_results"] = nlohmann::json::array();
+}
+
+void RunManifest::addGeneration(int generation, const std::vector<float> &fitness, int steps) {
+    nlohmann::json entry;
+    entry["generation"] = generation;
+    entry["steps"] = steps;
+    entry["best"] = fitness.empty() ? 0.0f : *std::max_element(fitness.begin(), fitness.end());
+    entry["fitness_hash"] = fitnessHash(fitness);
+    data["generation_results"].push_back(entry);
+}
+
+bool RunManifest::save(const std::string &path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[MANIFEST] Could not write " << path << "\n";
+        return false;
+    }
+    file << data.dump(4);
+    return true;
+}
+
+bool RunManifest::load(const std::string &path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[MANIFEST] Could not read " << path << "\n";
+        return false;
+    }
+
+    data = nlohmann::json::parse(file, nullptr, false);
+    if (data.is_discarded() || !data.contains("config") || !data.contains("seed")) {
+        std::cerr << "[MANIFEST] " << path << " is not a run manifest\n";
+        return false;
+    }
+    return true;
+}
+
+void RunManifest::apply() const {
+    VariableManager::fromJson(data["config"]);
+    VariableManager::setSeed(data["seed"].get<unsigned int>());
+    VariableManager::setSimulationTimestep(data.value("timestep", VariableManager::getSimulationTimestep()));
+}
+
+int RunManifest::firstMismatch(const RunManifest &other) const {
+    const nlohmann::json &ours = data["generation_results"];
+    const nlohmann::json &theirs = other.data["generation_results"];
+
+    for (size_t i = 0; i < ours.size() || i < theirs.size(); ++i) {
+        if (i >= ours.size() || i >= theirs.size() || ours[i]["fitness_hash"] != theirs[i]["fitness_hash"]) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
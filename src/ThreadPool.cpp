@@ -0,0 +1,120 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    for (int i = 0; i < threadCount; ++i) {
+        queues.emplace_back(std::make_unique<WorkQueue>());
+    }
+    for (int i = 0; i < threadCount - 1; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    wakeUp.notify_all();
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+bool ThreadPool::popTask(int queueIndex, Task &task) {
+    WorkQueue &queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::stealTask(int queueIndex, Task &task) {
+    int queueCount = (int)queues.size();
+    for (int offset = 1; offset < queueCount; ++offset) {
+        WorkQueue &queue = *queues[(queueIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::runTask(int queueIndex) {
+    Task task;
+    if (!popTask(queueIndex, task) && !stealTask(queueIndex, task)) {
+        return false;
+    }
+    queuedTasks--;
+
+    (*task.job->func)(task.begin, task.end);
+    task.job->remaining.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void ThreadPool::workerLoop(int queueIndex) {
+    while (running) {
+        if (runTask(queueIndex)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this] { return !running || queuedTasks > 0; });
+    }
+}
+
+void ThreadPool::parallelFor(int begin, int end, int grainSize, const std::function<void(int, int)> &func) {
+    if (end <= begin) return;
+    grainSize = std::max(1, grainSize);
+
+    int taskCount = (end - begin + grainSize - 1) / grainSize;
+    if (workers.empty() || taskCount == 1) {
+        func(begin, end);
+        return;
+    }
+
+    Job job;
+    job.func = &func;
+    job.remaining = taskCount;
+
+    // Contiguous blocks of ranges per queue, so every thread starts on its own part of the data
+    int queueCount = (int)queues.size();
+    for (int q = 0; q < queueCount; ++q) {
+        int firstTask = taskCount * q / queueCount;
+        int lastTask = taskCount * (q + 1) / queueCount;
+
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        // Pushed in reverse so the owner works front to back while thieves take the far end
+        for (int t = lastTask - 1; t >= firstTask; --t) {
+            int rangeBegin = begin + t * grainSize;
+            queues[q]->tasks.push_back({rangeBegin, std::min(end, rangeBegin + grainSize), &job});
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedTasks += taskCount;
+    }
+    wakeUp.notify_all();
+
+    // The calling thread helps until every range of this job is finished
+    int callerQueue = queueCount - 1;
+    while (job.remaining.load(std::memory_order_acquire) > 0) {
+        if (!runTask(callerQueue)) {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -3,14 +3,24 @@
 #include <cmath>
 #define M_PI 3.141592653589793238462643383279502884197169399375105820974944
 
-Tile::Tile(std::string path) {
+Tile::Tile(std::string path, const sf::Texture &atlas, const sf::IntRect &rect) {
     texturePath = path;
-    if (!texture.loadFromFile(path)) {
-        std::cerr << "Error loading texture from " << path << std::endl;
-    }
+    texture = &atlas;
+    textureRect = rect;
+    size = sf::Vector2u(rect.width, rect.height);
     initializeCollisionShape();
 }
 
+const sf::Texture& Tile::getTexture() const {
+    static const sf::Texture empty;
+    return texture ? *texture : empty;
+}
+
+void Tile::applyTo(sf::Sprite& sprite) const {
+    sprite.setTexture(getTexture());
+    sprite.setTextureRect(textureRect);
+}
+
 void Tile::addCollisionPoint(const sf::Vector2f& point) {
     collisionPolygon.emplace_back(point);
 }
@@ -19,9 +29,8 @@ void Tile::addCollisionPoint(const sf::Vector2f& point) {
 void Tile::initializeCollisionShape() {
     collisionPolygon.clear();
 
-    sf::Vector2u texSize = texture.getSize();
-    float width = static_cast<float>(texSize.x);
-    float height = static_cast<float>(texSize.y);
+    float width = static_cast<float>(size.x);
+    float height = static_cast<float>(size.y);
 
     if (texturePath.find("straight") != std::string::npos) {
         // Full rectangle for straight tiles
@@ -0,0 +1,149 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#include "TileAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+bool TileAtlas::pack(const std::vector<sf::Image> &images) {
+    rects.assign(images.size(), sf::IntRect());
+    if (images.empty()) {
+        return false;
+    }
+
+    // Shelf packing of the tallest images first, the width makes the atlas roughly square
+    std::vector<int> order(images.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&images](int a, int b) {
+        return images[a].getSize().y > images[b].getSize().y;
+    });
+
+    unsigned int area = 0;
+    unsigned int widest = 0;
+    for (const auto &source : images) {
+        sf::Vector2u size = source.getSize() + sf::Vector2u(2 * border, 2 * border);
+        area += size.x * size.y;
+        widest = std::max(widest, size.x);
+    }
+    unsigned int width = std::max(widest, (unsigned int)std::ceil(std::sqrt((double)area)));
+
+    std::vector<sf::Vector2u> positions(images.size());
+    unsigned int x = 0, y = 0, rowHeight = 0;
+    for (int i : order) {
+        sf::Vector2u size = images[i].getSize() + sf::Vector2u(2 * border, 2 * border);
+        if (x + size.x > width) {
+            x = 0;
+            y += rowHeight;
+            rowHeight = 0;
+        }
+        positions[i] = {x, y};
+        x += size.x;
+        rowHeight = std::max(rowHeight, size.y);
+    }
+
+    image.create(width, std::max(1u, y + rowHeight), sf::Color::Transparent);
+    for (size_t i = 0; i < images.size(); ++i) {
+        const sf::Image &source = images[i];
+        sf::Vector2u size = source.getSize();
+        if (size.x == 0 || size.y == 0) continue;
+
+        int left = (int)positions[i].x + border;
+        int top = (int)positions[i].y + border;
+        image.copy(source, left, top);
+
+        // Border pixels repeat the nearest edge pixel
+        for (int by = -border; by < (int)size.y + border; ++by) {
+            for (int bx = -border; bx < (int)size.x + border; ++bx) {
+                bool inside = bx >= 0 && by >= 0 && bx < (int)size.x && by < (int)size.y;
+                if (inside) {
+                    // Skip the interior of the row
+                    bx = (int)size.x - 1;
+                    continue;
+                }
+                unsigned int sx = std::clamp(bx, 0, (int)size.x - 1);
+                unsigned int sy = std::clamp(by, 0, (int)size.y - 1);
+                image.setPixel(left + bx, top + by, source.getPixel(sx, sy));
+            }
+        }
+
+        rects[i] = sf::IntRect(left, top, (int)size.x, (int)size.y);
+    }
+
+    std::cout << "[DEBUG] Packed " << images.size() << " tiles into a " << image.getSize().x << "x"
+              << image.getSize().y << " atlas\n";
+    return true;
+}
+
+bool TileAtlas::createTexture() {
+    if (!texture.loadFromImage(image)) {
+        std::cerr << "[DEBUG] Could not create the tile atlas texture of " << image.getSize().x << "x"
+                  << image.getSize().y << "\n";
+        return false;
+    }
+    return true;
+}
+
+std::string TileAtlas::stamp(const std::string &path) {
+    std::error_code error;
+    auto size = std::filesystem::file_size(path, error);
+    if (error) return "";
+    auto time = std::filesystem::last_write_time(path, error);
+    if (error) return "";
+    return std::to_string(size) + "," + std::to_string(time.time_since_epoch().count());
+}
+
+bool TileAtlas::loadCache(const std::string &path, const std::vector<std::string> &sources) {
+    std::ifstream file(path + ".csv");
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // One line per source: path,size,time,left,top,width,height
+    std::vector<sf::IntRect> cached;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::stringstream ss(line);
+        std::string source, size, time;
+        sf::IntRect rect;
+        char comma;
+        if (!std::getline(ss, source, ',') || !std::getline(ss, size, ',') || !std::getline(ss, time, ',') ||
+            !(ss >> rect.left >> comma >> rect.top >> comma >> rect.width >> comma >> rect.height)) {
+            return false;
+        }
+
+        size_t i = cached.size();
+        if (i >= sources.size() || source != sources[i] || size + "," + time != stamp(source)) {
+            return false;
+        }
+        cached.push_back(rect);
+    }
+    if (cached.size() != sources.size() || !image.loadFromFile(path + ".png")) {
+        return false;
+    }
+
+    rects = cached;
+    std::cout << "[DEBUG] Tile atlas loaded from " << path << ".png\n";
+    return true;
+}
+
+bool TileAtlas::saveCache(const std::string &path, const std::vector<std::string> &sources) const {
+    std::ofstream file(path + ".csv");
+    if (!file.is_open() || !image.saveToFile(path + ".png")) {
+        std::cerr << "[DEBUG] Could not write the tile atlas cache to " << path << "\n";
+        return false;
+    }
+
+    for (size_t i = 0; i < sources.size() && i < rects.size(); ++i) {
+        const sf::IntRect &rect = rects[i];
+        file << sources[i] << "," << stamp(sources[i]) << "," << rect.left << "," << rect.top << ","
+             << rect.width << "," << rect.height << "\n";
+    }
+    return true;
+}
@@ -0,0 +1,73 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#include "TileLayer.h"
+
+#include <iostream>
+
+void TileLayer::appendQuad(sf::VertexArray &quads, const sf::Sprite &tile) {
+    const sf::Transform &transform = tile.getTransform();
+    sf::FloatRect bounds = tile.getLocalBounds();
+    sf::IntRect rect = tile.getTextureRect();
+    sf::Color color = tile.getColor();
+
+    float left = static_cast<float>(rect.left);
+    float top = static_cast<float>(rect.top);
+    float right = left + static_cast<float>(rect.width);
+    float bottom = top + static_cast<float>(rect.height);
+
+    quads.append(sf::Vertex(transform.transformPoint(0, 0), color, {left, top}));
+    quads.append(sf::Vertex(transform.transformPoint(bounds.width, 0), color, {right, top}));
+    quads.append(sf::Vertex(transform.transformPoint(bounds.width, bounds.height), color, {right, bottom}));
+    quads.append(sf::Vertex(transform.transformPoint(0, bounds.height), color, {left, bottom}));
+}
+
+void TileLayer::bake(const sf::Vector2u &size, const sf::Sprite *background,
+                     const std::vector<std::vector<sf::Sprite>> &placedTileSprites) {
+    if (texture.getSize() != size && !texture.create(size.x, size.y)) {
+        std::cerr << "[DEBUG] Could not create the tile layer texture\n";
+        return;
+    }
+
+    texture.clear(sf::Color::Transparent);
+    if (background) {
+        texture.draw(*background);
+    }
+    // Tiles share the atlas, so they go out as one vertex array per texture run instead of a draw per tile
+    sf::VertexArray quads(sf::Quads);
+    const sf::Texture *batchTexture = nullptr;
+    auto flush = [&]() {
+        if (quads.getVertexCount() > 0) {
+            texture.draw(quads, sf::RenderStates(batchTexture));
+            quads.clear();
+        }
+    };
+
+    for (const auto &column : placedTileSprites) {
+        for (const auto &tile : column) {
+            // Empty cells have no texture
+            if (!tile.getTexture()) continue;
+            if (tile.getTexture() != batchTexture) {
+                flush();
+                batchTexture = tile.getTexture();
+            }
+            appendQuad(quads, tile);
+        }
+    }
+    flush();
+    texture.display();
+
+    sprite.setTexture(texture.getTexture(), true);
+    dirty = false;
+}
+
+void TileLayer::draw(sf::RenderTarget &target, const sf::Sprite *background,
+                     const std::vector<std::vector<sf::Sprite>> &placedTileSprites) {
+    // The texture covers the target, the sprite then goes through the same view the tiles would
+    sf::Vector2u size = target.getSize();
+    if (dirty || texture.getSize() != size) {
+        bake(size, background, placedTileSprites);
+    }
+    target.draw(sprite);
+}
@@ -0,0 +1,176 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#include "TrackCollision.h"
+
+#include <cmath>
+#include <algorithm>
+
+void TrackCollision::build(const sf::Vector2i &boundaries, float tileSize,
+                           const std::vector<std::vector<int>> &placedTileIDs,
+                           const std::vector<std::vector<sf::Sprite>> &placedTileSprites,
+                           const std::vector<Tile> &tiles) {
+    clear();
+    width = boundaries.x;
+    height = boundaries.y;
+    this->tileSize = tileSize;
+    cells.resize(static_cast<size_t>(width) * height);
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int tileID = placedTileIDs[x][y];
+            if (tileID < 0 || tileID >= tiles.size()) continue;
+
+            const sf::ConvexShape &collisionShape = tiles[tileID].collisionShape;
+            sf::Transform transform = placedTileSprites[x][y].getTransform() * collisionShape.getTransform();
+
+            int pointCount = static_cast<int>(collisionShape.getPointCount());
+            if (pointCount < 3) continue;
+
+            std::vector<sf::Vector2f> points(pointCount);
+            for (int i = 0; i < pointCount; ++i) {
+                points[i] = transform.transformPoint(collisionShape.getPoint(i));
+            }
+
+            Cell &cell = cells[static_cast<size_t>(y) * width + x];
+            cell.firstEdge = static_cast<int>(edges.size());
+            cell.edgeCount = pointCount;
+            cell.minX = cell.maxX = points[0].x;
+            cell.minY = cell.maxY = points[0].y;
+
+            for (int i = 0, j = pointCount - 1; i < pointCount; j = i++) {
+                Edge edge{};
+                edge.x0 = points[j].x;
+                edge.y0 = points[j].y;
+                edge.dx = points[i].x - points[j].x;
+                edge.dy = points[i].y - points[j].y;
+                edge.slopeX = (edge.dy != 0.0f) ? edge.dx / edge.dy : 0.0f;
+                edges.push_back(edge);
+
+                cell.minX = std::min(cell.minX, points[i].x);
+                cell.minY = std::min(cell.minY, points[i].y);
+                cell.maxX = std::max(cell.maxX, points[i].x);
+                cell.maxY = std::max(cell.maxY, points[i].y);
+            }
+        }
+    }
+}
+
+void TrackCollision::clear() {
+    width = 0;
+    height = 0;
+    cells.clear();
+    edges.clear();
+}
+
+bool TrackCollision::isPointInCell(const Cell &cell, float x, float y) const {
+    if (cell.edgeCount == 0 || x < cell.minX || x > cell.maxX || y < cell.minY || y > cell.maxY) {
+        return false;
+    }
+
+    // Crossing test, same rule as GameStateParent::isPointInPolygon
+    bool c = false;
+    const Edge *edge = &edges[cell.firstEdge];
+    for (int i = 0; i < cell.edgeCount; ++i, ++edge) {
+        float yi = edge->y0 + edge->dy;
+        float yj = edge->y0;
+        if ((yi > y) != (yj > y) && x < edge->slopeX * (y - yj) + edge->x0) {
+            c = !c;
+        }
+    }
+    return c;
+}
+
+bool TrackCollision::isPointOnTrack(const sf::Vector2f &point) const {
+    int tileX = static_cast<int>(point.x / tileSize);
+    int tileY = static_cast<int>(point.y / tileSize);
+
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            int x = tileX + dx;
+            int y = tileY + dy;
+            if (x < 0 || x >= width || y < 0 || y >= height) continue;
+
+            if (isPointInCell(cells[static_cast<size_t>(y) * width + x], point.x, point.y)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+float TrackCollision::castRay(const sf::Vector2f &origin, const sf::Vector2f &direction, float maxDistance) const {
+    const float epsilon = 1e-3f;
+
+    int cellX = static_cast<int>(std::floor(origin.x / tileSize));
+    int cellY = static_cast<int>(std::floor(origin.y / tileSize));
+    int stepX = (direction.x > 0) ? 1 : -1;
+    int stepY = (direction.y > 0) ? 1 : -1;
+
+    float tDeltaX = (direction.x != 0) ? tileSize / std::fabs(direction.x) : INFINITY;
+    float tDeltaY = (direction.y != 0) ? tileSize / std::fabs(direction.y) : INFINITY;
+
+    float tMaxX = INFINITY;
+    float tMaxY = INFINITY;
+    if (direction.x > 0) tMaxX = ((cellX + 1) * tileSize - origin.x) / direction.x;
+    if (direction.x < 0) tMaxX = (cellX * tileSize - origin.x) / direction.x;
+    if (direction.y > 0) tMaxY = ((cellY + 1) * tileSize - origin.y) / direction.y;
+    if (direction.y < 0) tMaxY = (cellY * tileSize - origin.y) / direction.y;
+
+    float tEnter = 0.0f;
+    while (tEnter < maxDistance) {
+        // Leaving the level or entering an empty cell ends the ray at the cell border
+        if (cellX < 0 || cellX >= width || cellY < 0 || cellY >= height) {
+            return tEnter;
+        }
+        const Cell &cell = cells[static_cast<size_t>(cellY) * width + cellX];
+        if (cell.edgeCount == 0) {
+            return tEnter;
+        }
+
+        float tExit = std::min(std::min(tMaxX, tMaxY), maxDistance);
+
+        // The ray enters the cell in a transparent area of the tile
+        float tProbe = tEnter + std::min(epsilon, (tExit - tEnter) * 0.5f);
+        if (!isPointInCell(cell, origin.x + direction.x * tProbe, origin.y + direction.y * tProbe)) {
+            return tEnter;
+        }
+
+        // Nearest polygon edge crossed inside this cell, edges on the cell border are handled by the next cell
+        float nearest = tExit;
+        bool hit = false;
+
+        const Edge *edge = &edges[cell.firstEdge];
+        for (int i = 0; i < cell.edgeCount; ++i, ++edge) {
+            float denominator = direction.x * edge->dy - direction.y * edge->dx;
+            if (std::fabs(denominator) < 1e-6f) continue;
+
+            float ox = edge->x0 - origin.x;
+            float oy = edge->y0 - origin.y;
+            float t = (ox * edge->dy - oy * edge->dx) / denominator;
+            float u = (ox * direction.y - oy * direction.x) / denominator;
+
+            if (u >= 0.0f && u <= 1.0f && t > tEnter + epsilon && t < tExit - epsilon && t < nearest) {
+                nearest = t;
+                hit = true;
+            }
+        }
+        if (hit) {
+            return nearest;
+        }
+
+        // Step into the next cell
+        if (tMaxX < tMaxY) {
+            cellX += stepX;
+            tEnter = tMaxX;
+            tMaxX += tDeltaX;
+        } else {
+            cellY += stepY;
+            tEnter = tMaxY;
+            tMaxY += tDeltaY;
+        }
+    }
+
+    return maxDistance;
+}
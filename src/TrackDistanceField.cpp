@@ -0,0 +1,157 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#include "TrackDistanceField.h"
+
+#include <cmath>
+#include <algorithm>
+
+void TrackDistanceField::build(const sf::Vector2f &levelSize, float texelSize,
+                               const std::function<bool(const sf::Vector2f &)> &isOnTrack) {
+    this->texelSize = texelSize;
+    width = std::max(1, static_cast<int>(std::ceil(levelSize.x / texelSize)));
+    height = std::max(1, static_cast<int>(std::ceil(levelSize.y / texelSize)));
+
+    size_t texels = static_cast<size_t>(width) * height;
+    occupancy.assign((texels + 63) / 64, 0);
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            sf::Vector2f center((x + 0.5f) * texelSize, (y + 0.5f) * texelSize);
+            if (isOnTrack(center)) {
+                size_t idx = static_cast<size_t>(y) * width + x;
+                occupancy[idx / 64] |= (std::uint64_t(1) << (idx % 64));
+            }
+        }
+    }
+
+    // Squared distances to the nearest texel of the other kind, the level is padded with one off-road texel
+    // so that the level border counts as the end of the road
+    const float infinity = 1e20f;
+    int paddedWidth = width + 2;
+    int paddedHeight = height + 2;
+    std::vector<float> inside(static_cast<size_t>(paddedWidth) * paddedHeight, 0.0f);
+    std::vector<float> outside(static_cast<size_t>(paddedWidth) * paddedHeight, infinity);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            size_t idx = static_cast<size_t>(y) * width + x;
+            size_t paddedIdx = static_cast<size_t>(y + 1) * paddedWidth + x + 1;
+            bool onTrack = (occupancy[idx / 64] >> (idx % 64)) & 1;
+            inside[paddedIdx] = onTrack ? infinity : 0.0f;
+            outside[paddedIdx] = onTrack ? 0.0f : infinity;
+        }
+    }
+    distanceTransform(inside, paddedWidth, paddedHeight);
+    distanceTransform(outside, paddedWidth, paddedHeight);
+
+    // The boundary lies halfway between two texels
+    distances.resize(texels);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            size_t idx = static_cast<size_t>(y) * width + x;
+            size_t paddedIdx = static_cast<size_t>(y + 1) * paddedWidth + x + 1;
+            bool onTrack = (occupancy[idx / 64] >> (idx % 64)) & 1;
+            float d = onTrack ? std::sqrt(inside[paddedIdx]) - 0.5f : -(std::sqrt(outside[paddedIdx]) - 0.5f);
+            distances[idx] = d * texelSize;
+        }
+    }
+}
+
+void TrackDistanceField::clear() {
+    width = 0;
+    height = 0;
+    occupancy.clear();
+    distances.clear();
+}
+
+void TrackDistanceField::distanceTransform(std::vector<float> &grid, int width, int height) {
+    // Felzenszwalb & Huttenlocher exact squared euclidean distance transform, first columns then rows
+    int n = std::max(width, height);
+    std::vector<float> f(n), d(n), z(n + 1);
+    std::vector<int> v(n);
+
+    auto transform1D = [&](int length) {
+        int k = 0;
+        v[0] = 0;
+        z[0] = -1e20f;
+        z[1] = 1e20f;
+        for (int q = 1; q < length; ++q) {
+            float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+            while (s <= z[k]) {
+                k--;
+                s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+            }
+            k++;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = 1e20f;
+        }
+        k = 0;
+        for (int q = 0; q < length; ++q) {
+            while (z[k + 1] < q) k++;
+            d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+        }
+    };
+
+    for (int x = 0; x < width; ++x) {
+        for (int y = 0; y < height; ++y) f[y] = grid[static_cast<size_t>(y) * width + x];
+        transform1D(height);
+        for (int y = 0; y < height; ++y) grid[static_cast<size_t>(y) * width + x] = d[y];
+    }
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) f[x] = grid[static_cast<size_t>(y) * width + x];
+        transform1D(width);
+        for (int x = 0; x < width; ++x) grid[static_cast<size_t>(y) * width + x] = d[x];
+    }
+}
+
+bool TrackDistanceField::isOnTrack(const sf::Vector2f &point) const {
+    if (point.x < 0 || point.y < 0) return false;
+
+    int x = static_cast<int>(point.x / texelSize);
+    int y = static_cast<int>(point.y / texelSize);
+    if (x >= width || y >= height) return false;
+
+    size_t idx = static_cast<size_t>(y) * width + x;
+    return (occupancy[idx / 64] >> (idx % 64)) & 1;
+}
+
+float TrackDistanceField::distance(const sf::Vector2f &point) const {
+    // Texel centers are the sample points, everything outside the level counts as off the road
+    float fx = point.x / texelSize - 0.5f;
+    float fy = point.y / texelSize - 0.5f;
+    if (fx < -0.5f || fy < -0.5f || fx > width - 0.5f || fy > height - 0.5f) return -texelSize;
+
+    fx = std::clamp(fx, 0.0f, static_cast<float>(width - 1));
+    fy = std::clamp(fy, 0.0f, static_cast<float>(height - 1));
+
+    int x0 = static_cast<int>(fx);
+    int y0 = static_cast<int>(fy);
+    int x1 = std::min(x0 + 1, width - 1);
+    int y1 = std::min(y0 + 1, height - 1);
+    float ax = fx - x0;
+    float ay = fy - y0;
+
+    float d00 = distances[static_cast<size_t>(y0) * width + x0];
+    float d10 = distances[static_cast<size_t>(y0) * width + x1];
+    float d01 = distances[static_cast<size_t>(y1) * width + x0];
+    float d11 = distances[static_cast<size_t>(y1) * width + x1];
+
+    return (d00 * (1 - ax) + d10 * ax) * (1 - ay) + (d01 * (1 - ax) + d11 * ax) * ay;
+}
+
+float TrackDistanceField::castRay(const sf::Vector2f &origin, const sf::Vector2f &direction, float maxDistance) const {
+    // The distance to the border is a safe step size, close to the border the field resolution is the limit
+    float threshold = texelSize * 0.25f;
+    float t = 0.0f;
+
+    while (t < maxDistance) {
+        float d = distance(origin + direction * t);
+        if (d <= threshold) {
+            return t;
+        }
+        t += std::max(d, threshold);
+    }
+    return maxDistance;
+}
@@ -10,23 +10,35 @@ float VariableManager::MAX_ANGULAR_ACCELERATION_CONSTANT = 200.0f; // Units: deg
 float VariableManager::MAX_SPEED = 450.0f; // Units: pixels per second
 float VariableManager::ROTATIONAL_SPEED_MULTIPLIER = 0.00425;
 float VariableManager::ANGULAR_DAMPING_MULTIPLIER = 0.99;
+float VariableManager::SIMULATION_TIMESTEP = 0.1f; // Units: seconds per AI simulation step
 
 // Car
 int VariableManager::SELECTED_CAR_INDEX = 0;
 
 // World
 float VariableManager::TILE_SIZE = 64;
+bool VariableManager::USE_DISTANCE_FIELD = false;
+float VariableManager::DISTANCE_FIELD_TEXEL_SIZE = 2.0f; // Units: pixels per texel
+
+// Performance
+int VariableManager::THREADS = 0; // 0 uses all hardware threads
+bool VariableManager::ADAPTIVE_SIMULATION_SPEED = false; // Steps per frame follow TARGET_FRAME_TIME
+float VariableManager::TARGET_FRAME_TIME = 16.6667f; // Units: milliseconds
+int VariableManager::MAX_STEPS_PER_FRAME = 256;
+bool VariableManager::THREADED_SIMULATION = false; // Simulation on its own thread, independent of the frame rate
 
 // Resources
 std::string VariableManager::FONT_RUBIK_REGULAR = "resources/Fonts/Rubik-Regular.ttf";
 std::string VariableManager::FONT_UPHEAVAL_PRO = "resources/Fonts/UpheavalPRO.ttf";
 std::string VariableManager::FONT_MENU_TITLE = "resources/Fonts/MenuTitle-Font.ttf";
 
-std::string VariableManager::PATH_TO_CONFIG = "resources/config/config.json";
+std::string VariableManager::PATH_TO_CONFIG = "resources/Config/config.json";
 std::string VariableManager::PATH_TO_TILE_CONFIG = "resources/Tiles/Tiles.csv";
-std::string VariableManager::PATH_TO_CAR_CONFIG = "resources/config/cars.csv";
+std::string VariableManager::TILE_ATLAS_CACHE = "resources/Tiles/atlas"; // .png and .csv are added, empty disables the cache
+std::string VariableManager::PATH_TO_CAR_CONFIG = "resources/Config/cars.csv";
 std::string VariableManager::PATH_TO_LEVELS = "resources/Levels/";
 std::string VariableManager::PATH_TO_BACKGROUNDS = "resources/Backgrounds/background";
+std::string VariableManager::PATH_TO_CHECKPOINTS = "resources/Checkpoints/";
 
 std::string VariableManager::IMAGE_CAR_CHOOSING_ARROW_LEFT = "resources/GUI/arrowleft.png";
 std::string VariableManager::IMAGE_CAR_CHOOSING_ARROW_RIGHT = "resources/GUI/arrowright.png";
@@ -37,6 +49,7 @@ std::string VariableManager::IMAGE_BACKGROUND_CAR_CHOOSING = "resources/Backgrou
 int VariableManager::RAY_AMOUNT = 8;
 float VariableManager::AI_FOV = 270.0f;
 int VariableManager::NETWORKS_AMOUNT = 200;
+bool VariableManager::USE_CPU_INFERENCE = false;
 float VariableManager::AI_INITIAL_RANDOM_VALUES_MAX = 1.6f;
 bool VariableManager::AI_INITIAL_RANDOM_VALUES_UNIFORM = true;
 std::vector<int> VariableManager::AI_TOPOLOGY = {RAY_AMOUNT, 6, OUTPUT_NEURONS};
@@ -53,12 +66,23 @@ float VariableManager::CHECKPOINT_RADIUS = 140.0f;
 float VariableManager::BACKWARDS_MOVEMENT_PENALTY = 5;
 float VariableManager::RESTART_ON_DEAD_PERCENTAGE = 0.995;
 float VariableManager::MUTATION_INDEX = 0.01f;
+std::string VariableManager::SELECTION_STRATEGY = "truncation"; // truncation, tournament, elitist_tournament, proportional, rank
+int VariableManager::TOURNAMENT_SIZE = 3;
+float VariableManager::RANK_PRESSURE = 1.5f; // Linear ranking pressure of the rank strategy, between 1 (uniform) and 2
+float VariableManager::STAGNATION_TIMEOUT = 0.0f; // Units: simulated seconds since the last checkpoint, 0 disables
+float VariableManager::MAX_GENERATION_TIME = 0.0f; // Units: simulated seconds, 0 disables
+float VariableManager::MIN_PROGRESS_RATE = 0.0f; // Units: checkpoints per simulated second, 0 disables
+unsigned int VariableManager::SEED = 0; // 0 draws a new seed for every run
 
 // DEBUG - RENDER
 bool VariableManager::SHOW_COLLIDERS = false;
 bool VariableManager::SHOW_CHECKPOINTS = false;
 bool VariableManager::SHOW_RAYS = false;
-bool VariableManager::SHOW_CARS_FIRST = false;
+bool VariableManager::SHOW_CARS_FIRST = false; // Only the current leader
+std::string VariableManager::RENDER_POLICY = "all"; // all, top, sample
+int VariableManager::RENDER_CAR_LIMIT = 100; // Cars drawn by the top and sample policies
+int VariableManager::POINT_SPRITE_THRESHOLD = 2000; // More shown cars are drawn as points, 0 disables
+int VariableManager::POINT_SPRITE_LEADERS = 10; // Best cars that keep their sprite when the others are points
 
 // Game
 bool VariableManager::AI_MODE = false;
@@ -74,6 +98,11 @@ std::string VariableManager::METRICS_MODE = "simple";
 
 // Save function
 void VariableManager::saveToJson(const std::string& filePath) {
+    std::ofstream file(filePath);
+    file << toJson().dump(4);
+}
+
+nlohmann::json VariableManager::toJson() {
     nlohmann::json jsonData;
     // Physics
     jsonData["MAX_ACCELERATION_CONSTANT"] = MAX_ACCELERATION_CONSTANT;
@@ -81,10 +110,20 @@ void VariableManager::saveToJson(const std::string& filePath) {
     jsonData["MAX_SPEED"] = MAX_SPEED;
     jsonData["ROTATIONAL_SPEED_MULTIPLIER"] = ROTATIONAL_SPEED_MULTIPLIER;
     jsonData["ANGULAR_DAMPING_MULTIPLIER"] = ANGULAR_DAMPING_MULTIPLIER;
+    jsonData["SIMULATION_TIMESTEP"] = SIMULATION_TIMESTEP;
     jsonData["SELECTED_CAR_INDEX"] = SELECTED_CAR_INDEX;
 
     // World
     jsonData["TILE_SIZE"] = TILE_SIZE;
+    jsonData["USE_DISTANCE_FIELD"] = USE_DISTANCE_FIELD;
+    jsonData["DISTANCE_FIELD_TEXEL_SIZE"] = DISTANCE_FIELD_TEXEL_SIZE;
+
+    // Performance
+    jsonData["THREADS"] = THREADS;
+    jsonData["ADAPTIVE_SIMULATION_SPEED"] = ADAPTIVE_SIMULATION_SPEED;
+    jsonData["TARGET_FRAME_TIME"] = TARGET_FRAME_TIME;
+    jsonData["MAX_STEPS_PER_FRAME"] = MAX_STEPS_PER_FRAME;
+    jsonData["THREADED_SIMULATION"] = THREADED_SIMULATION;
 
     // Resources
     jsonData["FONT_RUBIK_REGULAR"] = FONT_RUBIK_REGULAR;
@@ -93,9 +132,11 @@ void VariableManager::saveToJson(const std::string& filePath) {
 
     jsonData["PATH_TO_CONFIG"] = PATH_TO_CONFIG;
     jsonData["PATH_TO_TILE_CONFIG"] = PATH_TO_TILE_CONFIG;
+    jsonData["TILE_ATLAS_CACHE"] = TILE_ATLAS_CACHE;
     jsonData["PATH_TO_CAR_CONFIG"] = PATH_TO_CAR_CONFIG;
     jsonData["PATH_TO_LEVELS"] = PATH_TO_LEVELS;
     jsonData["PATH_TO_BACKGROUNDS"] = PATH_TO_BACKGROUNDS;
+    jsonData["PATH_TO_CHECKPOINTS"] = PATH_TO_CHECKPOINTS;
 
     jsonData["IMAGE_CAR_CHOOSING_ARROW_LEFT"] = IMAGE_CAR_CHOOSING_ARROW_LEFT;
     jsonData["IMAGE_CAR_CHOOSING_ARROW_RIGHT"] = IMAGE_CAR_CHOOSING_ARROW_RIGHT;
@@ -106,6 +147,7 @@ void VariableManager::saveToJson(const std::string& filePath) {
     jsonData["RAY_AMOUNT"] = RAY_AMOUNT;
     jsonData["AI_FOV"] = AI_FOV;
     jsonData["NETWORKS_AMOUNT"] = NETWORKS_AMOUNT;
+    jsonData["USE_CPU_INFERENCE"] = USE_CPU_INFERENCE;
     jsonData["AI_TOPOLOGY"] = AI_TOPOLOGY;
     jsonData["AI_INITIAL_RANDOM_VALUES_MAX"] = AI_INITIAL_RANDOM_VALUES_MAX;
     jsonData["AI_INITIAL_RANDOM_VALUES_UNIFORM"] = AI_INITIAL_RANDOM_VALUES_UNIFORM;
@@ -118,12 +160,23 @@ void VariableManager::saveToJson(const std::string& filePath) {
     jsonData["BACKWARDS_MOVEMENT_PENALTY"] = BACKWARDS_MOVEMENT_PENALTY;
     jsonData["RESTART_ON_DEAD_PERCENTAGE"] = RESTART_ON_DEAD_PERCENTAGE;
     jsonData["MUTATION_INDEX"] = MUTATION_INDEX;
+    jsonData["SELECTION_STRATEGY"] = SELECTION_STRATEGY;
+    jsonData["TOURNAMENT_SIZE"] = TOURNAMENT_SIZE;
+    jsonData["RANK_PRESSURE"] = RANK_PRESSURE;
+    jsonData["STAGNATION_TIMEOUT"] = STAGNATION_TIMEOUT;
+    jsonData["MAX_GENERATION_TIME"] = MAX_GENERATION_TIME;
+    jsonData["MIN_PROGRESS_RATE"] = MIN_PROGRESS_RATE;
+    jsonData["SEED"] = SEED;
 
     // Debug - Render
     jsonData["SHOW_COLLIDERS"] = SHOW_COLLIDERS;
     jsonData["SHOW_CHECKPOINTS"] = SHOW_CHECKPOINTS;
     jsonData["SHOW_RAYS"] = SHOW_RAYS;
     jsonData["SHOW_CARS_FIRST"] = SHOW_CARS_FIRST;
+    jsonData["RENDER_POLICY"] = RENDER_POLICY;
+    jsonData["RENDER_CAR_LIMIT"] = RENDER_CAR_LIMIT;
+    jsonData["POINT_SPRITE_THRESHOLD"] = POINT_SPRITE_THRESHOLD;
+    jsonData["POINT_SPRITE_LEADERS"] = POINT_SPRITE_LEADERS;
 
     // Game
     jsonData["AI_MODE"] = AI_MODE;
@@ -137,8 +190,7 @@ void VariableManager::saveToJson(const std::string& filePath) {
     jsonData["FPS_COUNTER"] = FPS_COUNTER;
     jsonData["METRICS_MODE"] = METRICS_MODE;
 
-    std::ofstream file(filePath);
-    file << jsonData.dump(4);
+    return jsonData;
 }
 
 // Load function
@@ -148,19 +200,32 @@ void VariableManager::loadFromJson(const std::string& filePath) {
 
     nlohmann::json jsonData;
     file >> jsonData;
+    fromJson(jsonData);
+}
 
+void VariableManager::fromJson(const nlohmann::json& jsonData) {
     // Physics
     MAX_ACCELERATION_CONSTANT = jsonData.value("MAX_ACCELERATION_CONSTANT", MAX_ACCELERATION_CONSTANT);
     MAX_ANGULAR_ACCELERATION_CONSTANT = jsonData.value("MAX_ANGULAR_ACCELERATION_CONSTANT", MAX_ANGULAR_ACCELERATION_CONSTANT);
     MAX_SPEED = jsonData.value("MAX_SPEED", MAX_SPEED);
     ROTATIONAL_SPEED_MULTIPLIER = jsonData.value("ROTATIONAL_SPEED_MULTIPLIER", ROTATIONAL_SPEED_MULTIPLIER);
     ANGULAR_DAMPING_MULTIPLIER = jsonData.value("ANGULAR_DAMPING_MULTIPLIER", ANGULAR_DAMPING_MULTIPLIER);
+    SIMULATION_TIMESTEP = jsonData.value("SIMULATION_TIMESTEP", SIMULATION_TIMESTEP);
 
     // Car
     SELECTED_CAR_INDEX = jsonData.value("SELECTED_CAR_INDEX", SELECTED_CAR_INDEX);
 
     // World
     TILE_SIZE = jsonData.value("TILE_SIZE", TILE_SIZE);
+    USE_DISTANCE_FIELD = jsonData.value("USE_DISTANCE_FIELD", USE_DISTANCE_FIELD);
+    DISTANCE_FIELD_TEXEL_SIZE = jsonData.value("DISTANCE_FIELD_TEXEL_SIZE", DISTANCE_FIELD_TEXEL_SIZE);
+
+    // Performance
+    THREADS = jsonData.value("THREADS", THREADS);
+    ADAPTIVE_SIMULATION_SPEED = jsonData.value("ADAPTIVE_SIMULATION_SPEED", ADAPTIVE_SIMULATION_SPEED);
+    TARGET_FRAME_TIME = jsonData.value("TARGET_FRAME_TIME", TARGET_FRAME_TIME);
+    MAX_STEPS_PER_FRAME = jsonData.value("MAX_STEPS_PER_FRAME", MAX_STEPS_PER_FRAME);
+    THREADED_SIMULATION = jsonData.value("THREADED_SIMULATION", THREADED_SIMULATION);
 
     // Resources
     FONT_RUBIK_REGULAR = jsonData.value("FONT_RUBIK_REGULAR", FONT_RUBIK_REGULAR);
@@ -169,9 +234,11 @@ void VariableManager::loadFromJson(const std::string& filePath) {
 
     PATH_TO_CONFIG = jsonData.value("PATH_TO_CONFIG", PATH_TO_CONFIG);
     PATH_TO_TILE_CONFIG = jsonData.value("PATH_TO_TILE_CONFIG", PATH_TO_TILE_CONFIG);
+    TILE_ATLAS_CACHE = jsonData.value("TILE_ATLAS_CACHE", TILE_ATLAS_CACHE);
     PATH_TO_CAR_CONFIG = jsonData.value("PATH_TO_CAR_CONFIG", PATH_TO_CAR_CONFIG);
     PATH_TO_LEVELS = jsonData.value("PATH_TO_LEVELS", PATH_TO_LEVELS);
     PATH_TO_BACKGROUNDS = jsonData.value("PATH_TO_BACKGROUNDS", PATH_TO_BACKGROUNDS);
+    PATH_TO_CHECKPOINTS = jsonData.value("PATH_TO_CHECKPOINTS", PATH_TO_CHECKPOINTS);
 
     IMAGE_CAR_CHOOSING_ARROW_LEFT = jsonData.value("IMAGE_CAR_CHOOSING_ARROW_LEFT", IMAGE_CAR_CHOOSING_ARROW_LEFT);
     IMAGE_CAR_CHOOSING_ARROW_RIGHT = jsonData.value("IMAGE_CAR_CHOOSING_ARROW_RIGHT", IMAGE_CAR_CHOOSING_ARROW_RIGHT);
@@ -182,6 +249,7 @@ void VariableManager::loadFromJson(const std::string& filePath) {
     RAY_AMOUNT = jsonData.value("RAY_AMOUNT", RAY_AMOUNT);
     AI_FOV = jsonData.value("AI_FOV", AI_FOV);
     NETWORKS_AMOUNT = jsonData.value("NETWORKS_AMOUNT", NETWORKS_AMOUNT);
+    USE_CPU_INFERENCE = jsonData.value("USE_CPU_INFERENCE", USE_CPU_INFERENCE);
     AI_TOPOLOGY = jsonData.value("AI_TOPOLOGY", AI_TOPOLOGY);
     AI_INITIAL_RANDOM_VALUES_MAX = jsonData.value("AI_INITIAL_RANDOM_VALUES_MAX", AI_INITIAL_RANDOM_VALUES_MAX);
     AI_INITIAL_RANDOM_VALUES_UNIFORM = jsonData.value("AI_INITIAL_RANDOM_VALUES_UNIFORM",AI_INITIAL_RANDOM_VALUES_UNIFORM);
@@ -194,12 +262,23 @@ void VariableManager::loadFromJson(const std::string& filePath) {
     BACKWARDS_MOVEMENT_PENALTY = jsonData.value("BACKWARDS_MOVEMENT_PENALTY", BACKWARDS_MOVEMENT_PENALTY);
     RESTART_ON_DEAD_PERCENTAGE = jsonData.value("RESTART_ON_DEAD_PERCENTAGE", RESTART_ON_DEAD_PERCENTAGE);
     MUTATION_INDEX = jsonData.value("MUTATION_INDEX", MUTATION_INDEX);
+    SELECTION_STRATEGY = jsonData.value("SELECTION_STRATEGY", SELECTION_STRATEGY);
+    TOURNAMENT_SIZE = jsonData.value("TOURNAMENT_SIZE", TOURNAMENT_SIZE);
+    RANK_PRESSURE = jsonData.value("RANK_PRESSURE", RANK_PRESSURE);
+    STAGNATION_TIMEOUT = jsonData.value("STAGNATION_TIMEOUT", STAGNATION_TIMEOUT);
+    MAX_GENERATION_TIME = jsonData.value("MAX_GENERATION_TIME", MAX_GENERATION_TIME);
+    MIN_PROGRESS_RATE = jsonData.value("MIN_PROGRESS_RATE", MIN_PROGRESS_RATE);
+    SEED = jsonData.value("SEED", SEED);
 
     // Debug - Render
     SHOW_COLLIDERS = jsonData.value("SHOW_COLLIDERS", SHOW_COLLIDERS);
     SHOW_CHECKPOINTS = jsonData.value("SHOW_CHECKPOINTS", SHOW_CHECKPOINTS);
     SHOW_RAYS = jsonData.value("SHOW_RAYS", SHOW_RAYS);
     SHOW_CARS_FIRST = jsonData.value("SHOW_CARS_PERCENTAGE", SHOW_CARS_FIRST);
+    RENDER_POLICY = jsonData.value("RENDER_POLICY", RENDER_POLICY);
+    RENDER_CAR_LIMIT = jsonData.value("RENDER_CAR_LIMIT", RENDER_CAR_LIMIT);
+    POINT_SPRITE_THRESHOLD = jsonData.value("POINT_SPRITE_THRESHOLD", POINT_SPRITE_THRESHOLD);
+    POINT_SPRITE_LEADERS = jsonData.value("POINT_SPRITE_LEADERS", POINT_SPRITE_LEADERS);
 
     // Game
     if(jsonData.contains("AI_MODE")) AI_MODE = jsonData["AI_MODE"].get<bool>();
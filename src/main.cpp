@@ -4,8 +4,35 @@
 
 #include "../include/Game.h"
 #include "../include/MenuState.h"
+#include "../include/HeadlessTrainer.h"
+#include "../include/Population.h"
+#include "../include/Benchmark.h"
+#include "../include/DistributedTrainer.h"
+
+int main(int argc, char *argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--worker") {
+            return DistributedTrainer::runWorker(argc, argv);
+        }
+        if (std::string(argv[i]) == "--headless") {
+            return HeadlessTrainer::runFromArguments(argc, argv);
+        }
+        if (std::string(argv[i]) == "--benchmark") {
+            return Benchmark::runFromArguments(argc, argv);
+        }
+        if (std::string(argv[i]) == "--verify-physics") {
+            VariableManager::loadFromJson(VariableManager::getPathToConfig());
+            return Population::verifyBatchUpdate(VariableManager::getNetworksAmount(), 100, 1e-4f) ? 0 : 1;
+        }
+        if (std::string(argv[i]) == "--verify-inference") {
+            VariableManager::loadFromJson(VariableManager::getPathToConfig());
+            return NeuralNetwork::verify_host_inference(VariableManager::getAiTopology(), VariableManager::getAiActivations(),
+                                                        VariableManager::getAiInitialRandomValuesMax(),
+                                                        VariableManager::getAiInitialRandomValuesUniform(),
+                                                        VariableManager::getNetworksAmount(), 1e-4f) ? 0 : 1;
+        }
+    }
 
-int main() {
     Game game;
     game.run();
     return 0;
@@ -4,6 +4,59 @@
 
 #include "NeuralNetwork.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NEURALNETWORK_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NEURALNETWORK_SIMD_SSE2
+#endif
+
+#if defined(_MSC_VER)
+#define NEURALNETWORK_RESTRICT __restrict
+#else
+#define NEURALNETWORK_RESTRICT __restrict__
+#endif
+
+namespace {
+    // z[k] += w[k] * a[k] over the networks of the range, separate multiply and add so every path rounds the same
+    void multiplyAdd(float *NEURALNETWORK_RESTRICT z, const float *NEURALNETWORK_RESTRICT w,
+                     const float *NEURALNETWORK_RESTRICT a, int count) {
+        int k = 0;
+#if defined(NEURALNETWORK_SIMD_AVX2)
+        for (; k + 8 <= count; k += 8) {
+            __m256 product = _mm256_mul_ps(_mm256_loadu_ps(w + k), _mm256_loadu_ps(a + k));
+            _mm256_storeu_ps(z + k, _mm256_add_ps(_mm256_loadu_ps(z + k), product));
+        }
+#elif defined(NEURALNETWORK_SIMD_SSE2)
+        for (; k + 4 <= count; k += 4) {
+            __m128 product = _mm_mul_ps(_mm_loadu_ps(w + k), _mm_loadu_ps(a + k));
+            _mm_storeu_ps(z + k, _mm_add_ps(_mm_loadu_ps(z + k), product));
+        }
+#endif
+        for (; k < count; ++k) z[k] += w[k] * a[k];
+    }
+
+    // z[k] += b[k]
+    void add(float *NEURALNETWORK_RESTRICT z, const float *NEURALNETWORK_RESTRICT b, int count) {
+        int k = 0;
+#if defined(NEURALNETWORK_SIMD_AVX2)
+        for (; k + 8 <= count; k += 8) {
+            _mm256_storeu_ps(z + k, _mm256_add_ps(_mm256_loadu_ps(z + k), _mm256_loadu_ps(b + k)));
+        }
+#elif defined(NEURALNETWORK_SIMD_SSE2)
+        for (; k + 4 <= count; k += 4) {
+            _mm_storeu_ps(z + k, _mm_add_ps(_mm_loadu_ps(z + k), _mm_loadu_ps(b + k)));
+        }
+#endif
+        for (; k < count; ++k) z[k] += b[k];
+    }
+}
+
 NeuralNetwork::NeuralNetwork(std::vector<int> &topology, std::vector<Utility::Activations> &activations, int n) {
     if(activations.size() != topology.size() - 1){
         std::cerr << "Sizes do not match!" << "\n";
@@ -41,6 +94,17 @@ NeuralNetwork::NeuralNetwork(std::vector<int> &topology, std::vector<Utility::Ac
     }
 }
 
+void NeuralNetwork::randomize(float min, float max, bool uniform) {
+    for (int i = 0; i < _weights.size(); ++i) {
+        af::dim4 weightDims = _weights[i].dims();
+        af::dim4 biasDims = _biases[i].dims();
+
+        _weights[i] = (uniform ? af::randu(weightDims, f32, _engine) : af::randn(weightDims, f32, _engine)) * (max - min) + min;
+        _biases[i] = (uniform ? af::randu(biasDims, f32, _engine) : af::randn(biasDims, f32, _engine)) * (max - min) + min;
+    }
+    _hostDirty = true;
+}
+
 af::array NeuralNetwork::feed_forward(af::array &input) {
     af::array value = input;
 
@@ -58,6 +122,66 @@ af::array NeuralNetwork::feed_forward(af::array &input) {
     // Get the batch size from the input
     dim_t batchSize = value.dims()[3];
 
+    // Move the batch into the columns, (inputs, batch, networks) is one batched matmul per layer
+    // against the untouched weights, the weights are never copied per batch entry
+    if (batchSize > 1) {
+        value = af::reorder(value, 0, 3, 2, 1);
+    }
+
+    for (int i = 0; i < _weights.size(); ++i) {
+        // z = activation(weights * inputs + biases)
+        value = af::matmul(_weights[i], value);
+        value += (batchSize > 1) ? af::tile(_biases[i], 1, (unsigned)batchSize) : _biases[i];
+        value = Utility::calculate_activation(value, _activations[i]);
+    }
+
+    if (batchSize > 1) {
+        value = af::reorder(value, 0, 3, 2, 1);
+    }
+
+    return value;
+}
+
+af::array NeuralNetwork::feed_forward(af::array &input, const af::array &networks) {
+    af::array value = input;
+
+    if (_weights.empty()) {
+        std::cerr << "The network does not possess any layers!" << "\n";
+        return value;
+    }
+
+    if (input.dims()[0] != _weights[0].dims()[1] || input.dims()[2] != networks.elements()) {
+        std::cerr << "The input dimension must match the first layer and the number of selected networks!" << "\n";
+        return value;
+    }
+
+    // Only the selected networks take part, their parameters are looked up along the network dimension
+    for (int i = 0; i < _weights.size(); ++i) {
+        value = af::matmul(af::lookup(_weights[i], networks, 2), value);
+        value += af::lookup(_biases[i], networks, 2);
+        value = Utility::calculate_activation(value, _activations[i]);
+    }
+
+    return value;
+}
+
+af::array NeuralNetwork::feed_forward_tiled(af::array &input) {
+    af::array value = input;
+
+    if (_weights.empty()) {
+        std::cerr << "The network does not possess any layers!" << "\n";
+        return value;
+    }
+
+    if (input.dims()[0] != _weights[0].dims()[1] || input.dims()[2] != _weights[0].dims()[2]) {
+        std::cerr << "The input dimension must match the first layer's weight dimensions!" << "\n";
+        return value;
+    }
+
+    // The batches are stored in the 4th dimension because the 3rd dimension is occupied by the networks
+    // Get the batch size from the input
+    dim_t batchSize = value.dims()[3];
+
     for (int i = 0; i < _weights.size(); ++i) {
 
         af::array weights = af::tile(_weights[i], 1, 1, 1, batchSize);
@@ -76,6 +200,160 @@ af::array NeuralNetwork::feed_forward(std::vector<float> &input){
     return feed_forward(in);
 }
 
+void NeuralNetwork::sync_host() {
+    if (!_hostDirty) return;
+
+    _hostTopology = topology();
+    _hostNetworks = _weights.empty() ? 0 : (int)_weights[0].dims()[2];
+    _hostWeights.resize(_weights.size());
+    _hostBiases.resize(_biases.size());
+
+    // ArrayFire stores (row, column, network) column major, the copy keeps the network index innermost
+    for (int i = 0; i < _weights.size(); ++i) {
+        int rows = (int)_weights[i].dims()[0];
+        int cols = (int)_weights[i].dims()[1];
+
+        std::vector<float> weights = Utility::arrayToVector(_weights[i]);
+        std::vector<float> biases = Utility::arrayToVector(_biases[i]);
+
+        _hostWeights[i].resize(weights.size());
+        _hostBiases[i].resize(biases.size());
+        for (int k = 0; k < _hostNetworks; ++k) {
+            for (int c = 0; c < cols; ++c) {
+                for (int r = 0; r < rows; ++r) {
+                    _hostWeights[i][((size_t)r * cols + c) * _hostNetworks + k] = weights[r + (size_t)c * rows + (size_t)k * rows * cols];
+                }
+            }
+            for (int r = 0; r < rows; ++r) {
+                _hostBiases[i][(size_t)r * _hostNetworks + k] = biases[r + (size_t)k * rows];
+            }
+        }
+    }
+
+    _hostDirty = false;
+}
+
+void NeuralNetwork::feed_forward_host(const float *input, float *output) {
+    sync_host();
+    feed_forward_host(input, output, 0, _hostNetworks);
+}
+
+void NeuralNetwork::feed_forward_host(const float *input, float *output, int begin, int end) {
+    feed_forward_host(input, output, nullptr, begin, end);
+}
+
+void NeuralNetwork::feed_forward_host(const float *input, float *output, const int *indices, int begin, int end) {
+    if (_hostDirty || _hostTopology.empty()) {
+        std::cerr << "The host weights are not synchronized, call sync_host first!" << "\n";
+        return;
+    }
+
+    int count = end - begin;
+    int inputs = _hostTopology.front();
+    int outputs = _hostTopology.back();
+
+    // Values are kept per neuron with the networks of the range next to each other,
+    // so every multiply-add below runs over contiguous memory with the SIMD helpers above
+    thread_local std::vector<float> current;
+    thread_local std::vector<float> next;
+    // Parameters of the indexed networks, gathered so the loops below stay contiguous
+    thread_local std::vector<float> gathered;
+
+    auto network = [indices, begin](int k) { return indices ? indices[begin + k] : begin + k; };
+
+    current.resize((size_t)inputs * count);
+    for (int k = 0; k < count; ++k) {
+        for (int j = 0; j < inputs; ++j) {
+            current[(size_t)j * count + k] = input[(size_t)network(k) * inputs + j];
+        }
+    }
+    if (indices) gathered.resize(count);
+
+    auto parameters = [&](const std::vector<float> &values, size_t offset) -> const float * {
+        if (!indices) return &values[offset + begin];
+        for (int k = 0; k < count; ++k) gathered[k] = values[offset + indices[begin + k]];
+        return gathered.data();
+    };
+
+    for (int i = 0; i < _hostWeights.size(); ++i) {
+        int rows = _hostTopology[i + 1];
+        int cols = _hostTopology[i];
+        next.resize((size_t)rows * count);
+
+        for (int r = 0; r < rows; ++r) {
+            float *z = &next[(size_t)r * count];
+
+            // z = activation(weights * inputs + biases)
+            std::fill(z, z + count, 0.0f);
+            for (int c = 0; c < cols; ++c) {
+                const float *w = parameters(_hostWeights[i], ((size_t)r * cols + c) * _hostNetworks);
+                multiplyAdd(z, w, &current[(size_t)c * count], count);
+            }
+            add(z, parameters(_hostBiases[i], (size_t)r * _hostNetworks), count);
+        }
+
+        Utility::calculate_activation(next.data(), next.size(), _activations[i]);
+        std::swap(current, next);
+    }
+
+    for (int k = 0; k < count; ++k) {
+        for (int r = 0; r < outputs; ++r) {
+            output[(size_t)network(k) * outputs + r] = current[(size_t)r * count + k];
+        }
+    }
+}
+
+float NeuralNetwork::host_deviation(af::array &input) {
+    std::vector<float> inputData = Utility::arrayToVector(input);
+    std::vector<float> expected = Utility::arrayToVector(feed_forward(input));
+
+    std::vector<float> actual(expected.size(), 0.0f);
+    feed_forward_host(inputData.data(), actual.data());
+
+    float deviation = 0.0f;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        deviation = std::max(deviation, std::abs(expected[i] - actual[i]));
+    }
+
+    // The indexed paths on every third network
+    int inputs = _hostTopology.front();
+    int outputs = _hostTopology.back();
+    std::vector<int> indices;
+    for (int k = 0; k < _hostNetworks; k += 3) indices.push_back(k);
+    int count = (int)indices.size();
+
+    std::vector<float> indexed(expected.size(), 0.0f);
+    feed_forward_host(inputData.data(), indexed.data(), indices.data(), 0, count);
+
+    std::vector<float> compactInput((size_t)inputs * count);
+    for (int k = 0; k < count; ++k) {
+        std::copy(&inputData[(size_t)indices[k] * inputs], &inputData[(size_t)(indices[k] + 1) * inputs], &compactInput[(size_t)k * inputs]);
+    }
+    af::array compactInputAf(inputs, 1, count, compactInput.data());
+    af::array indicesAf(count, indices.data());
+    std::vector<float> compactOutput = Utility::arrayToVector(feed_forward(compactInputAf, indicesAf));
+
+    for (int k = 0; k < count; ++k) {
+        for (int r = 0; r < outputs; ++r) {
+            size_t i = (size_t)indices[k] * outputs + r;
+            deviation = std::max(deviation, std::abs(expected[i] - indexed[i]));
+            deviation = std::max(deviation, std::abs(expected[i] - compactOutput[(size_t)k * outputs + r]));
+        }
+    }
+    return deviation;
+}
+
+bool NeuralNetwork::verify_host_inference(std::vector<int> &topology, std::vector<Utility::Activations> &activations,
+                                          float randomMax, bool uniform, int networks, float tolerance) {
+    Utility::setup();
+    NeuralNetwork network(topology, activations, -randomMax, +randomMax, uniform, networks);
+
+    af::array input = af::randu(topology[0], 1, networks) * 1000.0f;
+    float deviation = network.host_deviation(input);
+    std::cout << "[DEBUG] Host inference deviates by at most " << deviation << " from ArrayFire over " << networks << " networks\n";
+    return deviation <= tolerance;
+}
+
 af::array NeuralNetwork::feed_forward_single(af::array &input, int index){
     af::array value = input;
 
@@ -93,19 +371,19 @@ af::array NeuralNetwork::feed_forward_single(af::array &input, int index){
     // Get the batch size from the input
     dim_t batchSize = value.dims()[2];
 
+    // The batch becomes the columns of a single matmul instead of a tiled copy of the network
+    value = af::moddims(value, value.dims()[0], batchSize);
+
     for (int i = 0; i < _weights.size(); ++i) {
         af::array weightSlice = af::lookup(_weights[i], lookup, 2);
         af::array biasSlice = af::lookup(_biases[i], lookup, 2);
 
-        weightSlice = af::tile(weightSlice, 1, 1, batchSize);
-        biasSlice = af::tile(biasSlice, 1, 1, batchSize);
-
         // z = activation(weights * inputs + biases)
-        value = af::matmul(weightSlice, value) + biasSlice;
+        value = af::matmul(weightSlice, value) + af::tile(biasSlice, 1, (unsigned)batchSize);
         value = Utility::calculate_activation(value, _activations[i]);
     }
 
-    return value;
+    return af::moddims(value, value.dims()[0], 1, batchSize);
 }
 
 af::array NeuralNetwork::feed_forward_single(std::vector<float> &input, int index){
@@ -113,7 +391,7 @@ af::array NeuralNetwork::feed_forward_single(std::vector<float> &input, int inde
     return feed_forward_single(in, index);
 }
 
-void NeuralNetwork::breed(std::vector<float> &fitness, int winners, float min, float max, bool uniform) {
+void NeuralNetwork::breed(af::array &fitness, int winners, float min, float max, bool uniform) {
     if (_weights.empty()) {
         std::cerr << "The network does not possess any layers!" << "\n";
         return;
@@ -121,97 +399,199 @@ void NeuralNetwork::breed(std::vector<float> &fitness, int winners, float min, f
 
     unsigned int numNetworks = _weights[0].dims()[2];
 
-    if(winners > numNetworks){
+    if(winners > numNetworks || winners <= 0){
         std::cerr << "The number of winners cannot be higher than the number of networks!\n";
         return;
     }
 
-    // Buffer for child networks
-    std::vector<af::array> weights;
-    std::vector<af::array> biases;
+    // Find the best neural networks, topk only supports small k on some backends
+    af::array values, selectedIdx;
+    af::array flatFitness = af::flat(fitness);
+    if (winners <= 256) {
+        af::topk(values, selectedIdx, flatFitness, winners, 0, AF_TOPK_MAX);
+    } else {
+        af::sort(values, selectedIdx, flatFitness, 0, false);
+        selectedIdx = selectedIdx(af::seq(0, winners - 1));
+    }
+    selectedIdx = selectedIdx.as(u32);
 
-    // Already apply the mutation values at start
-    for (int i = 0; i < _weights.size(); ++i) {
-        if(uniform){
-            weights.emplace_back(af::randu(_weights[i].dims()) * (max - min) + min);
-            biases.emplace_back(af::randu(_biases[i].dims()) * (max - min) + min);
-        }else{
-            weights.emplace_back(af::randn(_weights[i].dims()) * (max - min) + min);
-            biases.emplace_back(af::randn(_biases[i].dims()) * (max - min) + min);
-        }
+    // Decide the breeding pairs, indices into the winners mapped to network indices.
+    // Before, the rank itself was used as the network index, so the parents were networks 0..winners-1
+    // and not the winners. Runs from before this change train differently and cannot be compared seed by seed.
+    unsigned int numPairs = numNetworks - winners;
+    af::array n1Array, n2Array;
+    if (numPairs > 0) {
+        af::array pick1 = af::min(af::floor(af::randu(af::dim4(numPairs), f32, _engine) * (float)winners), (float)(winners - 1));
+        af::array pick2 = af::min(af::floor(af::randu(af::dim4(numPairs), f32, _engine) * (float)winners), (float)(winners - 1));
+        n1Array = af::lookup(selectedIdx, pick1.as(u32));
+        n2Array = af::lookup(selectedIdx, pick2.as(u32));
     }
 
-    // Find the best neural networks
-    auto selectedNetworks = Utility::find_top_n(fitness, winners);
+    breed(selectedIdx, n1Array, n2Array, min, max, uniform);
+}
 
-    // Copy the winners into the children to preserve them
-    af::array selectedIdxArray(1, selectedNetworks.size(), selectedNetworks.data());
+void NeuralNetwork::breed(const af::array &selectedIdx, const af::array &n1Array, const af::array &n2Array,
+                          float min, float max, bool uniform) {
+    unsigned int numNetworks = _weights[0].dims()[2];
+    unsigned int winners = selectedIdx.isempty() ? 0 : (unsigned int)selectedIdx.elements();
+    unsigned int numPairs = n1Array.isempty() ? 0 : (unsigned int)n1Array.elements();
+
+    if (winners + numPairs != numNetworks) {
+        std::cerr << "The selection has to fill every network!\n";
+        return;
+    }
+
+    // The back buffers keep their allocation from the last generation
+    if (_weightsBack.size() != _weights.size()) {
+        _weightsBack.assign(_weights.size(), af::array());
+        _biasesBack.assign(_biases.size(), af::array());
+    }
 
     for (int layer = 0; layer < _weights.size(); ++layer) {
-        af::array selectedWeights = af::lookup(_weights[layer], selectedIdxArray.as(u32), 2);
-        af::array selectedBiases = af::lookup(_biases[layer], selectedIdxArray.as(u32), 2);
+        af::dim4 wDims = _weights[layer].dims();
+        af::dim4 bDims = _biases[layer].dims();
+
+        if (_weightsBack[layer].dims() != wDims) {
+            _weightsBack[layer] = af::array(wDims);
+            _biasesBack[layer] = af::array(bDims);
+        }
+
+        // Copy the winners into the children to preserve them
+        if (winners > 0) {
+            af::seq winnerSeq(0, winners - 1);
+            _weightsBack[layer](af::span, af::span, winnerSeq) = af::lookup(_weights[layer], selectedIdx, 2);
+            _biasesBack[layer](af::span, af::span, winnerSeq) = af::lookup(_biases[layer], selectedIdx, 2);
+        }
+
+        if (numPairs == 0) continue;
 
-        // Assign the selected weights and biases to the first numSelectedNetworks positions
-        af::seq destSeq(0, selectedNetworks.size() - 1);
+        af::dim4 wChildDims(wDims[0], wDims[1], numPairs);
+        af::dim4 bChildDims(bDims[0], bDims[1], numPairs);
 
-        weights[layer](af::span, af::span, destSeq) = selectedWeights;
-        biases[layer](af::span, af::span, destSeq) = selectedBiases;
+        // Generate masks for all network pairs
+        af::array wMasks = af::randu(wChildDims, f32, _engine) > 0.5f;
+        af::array bMasks = af::randu(bChildDims, f32, _engine) > 0.5f;
+
+        // Mutation values
+        af::array wMutation = (uniform ? af::randu(wChildDims, f32, _engine) : af::randn(wChildDims, f32, _engine)) * (max - min) + min;
+        af::array bMutation = (uniform ? af::randu(bChildDims, f32, _engine) : af::randn(bChildDims, f32, _engine)) * (max - min) + min;
+
+        // Cross the values of the parents selected by the masks and mutate
+        af::seq childSeq(winners, winners + numPairs - 1);
+        _weightsBack[layer](af::span, af::span, childSeq) =
+                af::select(wMasks, af::lookup(_weights[layer], n1Array, 2), af::lookup(_weights[layer], n2Array, 2)) + wMutation;
+        _biasesBack[layer](af::span, af::span, childSeq) =
+                af::select(bMasks, af::lookup(_biases[layer], n1Array, 2), af::lookup(_biases[layer], n2Array, 2)) + bMutation;
     }
 
-    // Decide the breeding pairs
-    unsigned int numPairs = numNetworks - winners;
-    std::vector<unsigned int> n1Vec(numPairs), n2Vec(numPairs);
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, selectedNetworks.size() - 1);
+    // The children become the networks, the parents are overwritten next generation
+    std::swap(_weights, _weightsBack);
+    std::swap(_biases, _biasesBack);
+    _hostDirty = true;
+}
 
-    for(int i = 0; i < numPairs; ++i){
-        int idx1 = dis(gen);
-        int idx2 = dis(gen);
+void NeuralNetwork::breed(std::vector<float> &fitness, int winners, float min, float max, bool uniform){
+    af::array in = Utility::vectorToArray(fitness);
+    breed(in, winners, min, max, uniform);
+}
 
-        n1Vec[i] = idx1;
-        n2Vec[i] = idx2;
+void NeuralNetwork::breed(std::vector<float> &fitness, SelectionStrategy &strategy, int elites, float min, float max,
+                          bool uniform) {
+    if (_weights.empty()) {
+        std::cerr << "The network does not possess any layers!" << "\n";
+        return;
     }
-    af::array n1Array(1, numPairs, n1Vec.data());
-    af::array n2Array(1, numPairs, n2Vec.data());
 
-    // Cross the values of the networks
-    for (int layer = 0; layer < _weights.size(); ++layer) {
-        af::dim4 wDims = _weights[layer].dims();
-        af::dim4 bDims = _biases[layer].dims();
+    int numNetworks = _weights[0].dims()[2];
+    if (fitness.size() != numNetworks || elites > numNetworks) {
+        std::cerr << "The fitness has to contain one value per network!\n";
+        return;
+    }
 
-        // Generate masks for all network pairs
-        af::array wMasks = af::randu(wDims[0], wDims[1], numPairs) > 0.5f;
-        af::array bMasks = af::randu(bDims[0], bDims[1], numPairs) > 0.5f;
+    // The selection only produces indices, the weights never leave the device
+    Selection selection;
+    strategy.select(fitness, std::max(elites, 0), numNetworks - std::max(elites, 0), selection);
 
-        // Extract parent weights and biases using the lookup function along the third dimension
-        af::array parent1Weights = af::lookup(_weights[layer], n1Array.as(u32), 2);
-        af::array parent2Weights = af::lookup(_weights[layer], n2Array.as(u32), 2);
+    af::array selectedIdx, n1Array, n2Array;
+    if (!selection.elites.empty()) selectedIdx = af::array((dim_t)selection.elites.size(), selection.elites.data());
+    if (!selection.parents1.empty()) n1Array = af::array((dim_t)selection.parents1.size(), selection.parents1.data());
+    if (!selection.parents2.empty()) n2Array = af::array((dim_t)selection.parents2.size(), selection.parents2.data());
 
-        af::array parent1Biases = af::lookup(_biases[layer], n1Array.as(u32), 2);
-        af::array parent2Biases = af::lookup(_biases[layer], n2Array.as(u32), 2);
+    breed(selectedIdx, n1Array, n2Array, min, max, uniform);
+}
 
-        // Perform crossover using masks
-        af::array newWeights = parent1Weights * wMasks + parent2Weights * (1 - wMasks);
-        af::array newBiases = parent1Biases * bMasks + parent2Biases * (1 - bMasks);
+std::vector<float> NeuralNetwork::get_genome(int index) {
+    std::vector<float> genome;
+    for (int layer = 0; layer < _weights.size(); ++layer) {
+        std::vector<float> w = Utility::arrayToVector(_weights[layer](af::span, af::span, index));
+        genome.insert(genome.end(), w.begin(), w.end());
+    }
+    for (int layer = 0; layer < _biases.size(); ++layer) {
+        std::vector<float> b = Utility::arrayToVector(_biases[layer](af::span, af::span, index));
+        genome.insert(genome.end(), b.begin(), b.end());
+    }
+    return genome;
+}
 
-        // Assign the new weights and biases to the appropriate slices
-        af::seq destSeq(winners, winners + numPairs - 1);
+void NeuralNetwork::set_genome(int index, const std::vector<float> &genome) {
+    size_t offset = 0;
+    size_t expected = 0;
+    for (int layer = 0; layer < _weights.size(); ++layer) {
+        expected += _weights[layer].dims()[0] * _weights[layer].dims()[1] + _biases[layer].dims()[0];
+    }
+    if (genome.size() != expected) {
+        std::cerr << "The genome does not match the topology of the network!\n";
+        return;
+    }
 
-        weights[layer](af::span, af::span, destSeq) += newWeights;
-        biases[layer](af::span, af::span, destSeq) += newBiases;
+    for (int layer = 0; layer < _weights.size(); ++layer) {
+        dim_t rows = _weights[layer].dims()[0];
+        dim_t cols = _weights[layer].dims()[1];
+        _weights[layer](af::span, af::span, index) = af::array(rows, cols, genome.data() + offset);
+        offset += rows * cols;
+    }
+    for (int layer = 0; layer < _biases.size(); ++layer) {
+        dim_t rows = _biases[layer].dims()[0];
+        _biases[layer](af::span, af::span, index) = af::array(rows, 1, genome.data() + offset);
+        offset += rows;
     }
+    _hostDirty = true;
+}
 
-    // Copy the children into the networks
+std::vector<float> NeuralNetwork::export_networks(int begin, int end) {
+    std::vector<float> data;
     for (int layer = 0; layer < _weights.size(); ++layer) {
-        _weights[layer] = weights[layer];
-        _biases[layer] = biases[layer];
+        std::vector<float> w = Utility::arrayToVector(_weights[layer](af::span, af::span, af::seq(begin, end - 1)));
+        std::vector<float> b = Utility::arrayToVector(_biases[layer](af::span, af::span, af::seq(begin, end - 1)));
+        data.insert(data.end(), w.begin(), w.end());
+        data.insert(data.end(), b.begin(), b.end());
     }
+    return data;
 }
 
-void NeuralNetwork::breed(af::array &fitness, int winners, float min, float max, bool uniform){
-    auto in = Utility::arrayToVector(fitness);
-    breed(in, winners, min, max, uniform);
+bool NeuralNetwork::import_networks(const float *data, size_t size) {
+    size_t perNetwork = 0;
+    for (int layer = 0; layer < _weights.size(); ++layer) {
+        perNetwork += _weights[layer].dims()[0] * _weights[layer].dims()[1] + _biases[layer].dims()[0];
+    }
+    if (perNetwork == 0 || size % perNetwork != 0) {
+        std::cerr << "The data does not match the topology of the network!\n";
+        return false;
+    }
+
+    dim_t n = (dim_t)(size / perNetwork);
+    size_t offset = 0;
+    for (int layer = 0; layer < _weights.size(); ++layer) {
+        dim_t rows = _weights[layer].dims()[0];
+        dim_t cols = _weights[layer].dims()[1];
+
+        _weights[layer] = af::array(rows, cols, n, data + offset);
+        offset += rows * cols * n;
+        _biases[layer] = af::array(rows, 1, n, data + offset);
+        offset += rows * n;
+    }
+    _hostDirty = true;
+    return true;
 }
 
 int NeuralNetwork::networks() {
@@ -255,7 +635,40 @@ std::vector<int> NeuralNetwork::topology() {
     return output;
 }
 
-bool NeuralNetwork::save(std::string path, int n)
+bool NeuralNetwork::save(std::string path, int amount) {
+    return is_binary_path(path) ? save_binary(path, amount) : save_json(path, amount);
+}
+
+bool NeuralNetwork::load(std::string path) {
+    return is_binary_path(path) ? load_binary(path) : load_json(path);
+}
+
+bool NeuralNetwork::is_binary_path(const std::string &path) {
+    return path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+}
+
+af::array NeuralNetwork::repeat_networks(const af::array &saved, int networks) {
+    int savedNetworks = (int)saved.dims()[2];
+
+    // Calculate how many full repeats we need, plus any leftover
+    int fullRepeats = networks / savedNetworks;
+    int leftover    = networks % savedNetworks;
+
+    // Repeat the entire block 'fullRepeats' times
+    af::array repeated = af::tile(saved, 1, 1, fullRepeats, 1);
+
+    // If there's a remainder, append a partial slice
+    if (leftover > 0) {
+        repeated = af::join(
+                2,
+                repeated,
+                saved(af::span, af::span, af::seq(0, leftover - 1), af::span)
+        );
+    }
+    return repeated;
+}
+
+bool NeuralNetwork::save_json(const std::string &path, int n)
 {
     // Ensure that n does not exceed the actual number of networks
     int numNetworks = this->networks(); // the total networks in the 3rd dimension
@@ -311,7 +724,7 @@ bool NeuralNetwork::save(std::string path, int n)
     return true;
 }
 
-bool NeuralNetwork::load(std::string path) {
+bool NeuralNetwork::load_json(const std::string &path) {
     std::ifstream file(path);
     if (!file.is_open()) {
         std::cerr << "Failed to open file for reading: " << path << "\n";
@@ -338,7 +751,7 @@ bool NeuralNetwork::load(std::string path) {
         loadedActivations[i] = static_cast<Utility::Activations>(actVec[i]);
     }
 
-    int networks = _weights[0].dims(2);
+    int networks = _weights.empty() ? net : (int)_weights[0].dims(2);
 
     _weights.clear();
     _biases.clear();
@@ -362,35 +775,216 @@ bool NeuralNetwork::load(std::string path) {
         // Check if 'net' is greater than what was actually saved in this layer
         int savedNetworks = wArr.dims()[2]; // number of networks in the 3rd dimension
         if (net > savedNetworks && savedNetworks > 0) {
-            // Calculate how many full repeats we need, plus any leftover
-            int fullRepeats = (networks) / savedNetworks;
-            int leftover    = networks % savedNetworks;
-
-            // Repeat the entire block 'fullRepeats' times
-            af::array wRepeated = af::tile(wArr, 1, 1, fullRepeats, 1);
-            af::array bRepeated = af::tile(bArr, 1, 1, fullRepeats, 1);
-
-            // If there's a remainder, append a partial slice
-            if (leftover > 0) {
-                wRepeated = af::join(
-                        2,
-                        wRepeated,
-                        wArr(af::span, af::span, af::seq(0, leftover - 1), af::span)
-                );
-                bRepeated = af::join(
-                        2,
-                        bRepeated,
-                        bArr(af::span, af::span, af::seq(0, leftover - 1), af::span)
-                );
-            }
-            wArr = wRepeated;
-            bArr = bRepeated;
+            wArr = repeat_networks(wArr, networks);
+            bArr = repeat_networks(bArr, networks);
         }
         // If net <= savedNetworks, or savedNetworks == 0, we do nothing special.
 
         _weights.push_back(wArr);
         _biases.push_back(bArr);
     }
+    _hostDirty = true;
+
+    return true;
+}
+
+namespace {
+    // Binary format: "IDNN", version, layer count, saved networks, total networks, topology,
+    // activations as little endian uint32, then per layer the weights and biases as little endian
+    // float32 in ArrayFire's column major order
+    constexpr char BINARY_MAGIC[4] = {'I', 'D', 'N', 'N'};
+    constexpr uint32_t BINARY_VERSION = 1;
+    // Limits for the header fields of a loaded file, anything above is treated as corrupt
+    constexpr uint32_t BINARY_MAX_LAYERS = 1024;
+    constexpr uint32_t BINARY_MAX_NEURONS = 1u << 16;
+    constexpr uint32_t BINARY_MAX_NETWORKS = 1u << 20;
+
+    // out = a * b, false if it does not fit into size_t
+    bool multiply_size(size_t a, size_t b, size_t &out) {
+        if (a != 0 && b > SIZE_MAX / a) return false;
+        out = a * b;
+        return true;
+    }
+
+    bool host_is_little_endian() {
+        const uint32_t probe = 1;
+        unsigned char first;
+        std::memcpy(&first, &probe, 1);
+        return first == 1;
+    }
+
+    uint32_t swap_bytes(uint32_t value) {
+        return (value >> 24) | ((value >> 8) & 0xFF00u) | ((value << 8) & 0xFF0000u) | (value << 24);
+    }
+
+    // Converts 4 byte values between host and little endian order, does nothing on little endian hosts
+    void to_little_endian(void *data, size_t count) {
+        if (host_is_little_endian()) return;
+        auto *values = static_cast<uint32_t *>(data);
+        for (size_t i = 0; i < count; ++i) values[i] = swap_bytes(values[i]);
+    }
+
+    void write_values(std::ofstream &file, std::vector<uint32_t> values) {
+        to_little_endian(values.data(), values.size());
+        file.write(reinterpret_cast<const char *>(values.data()), (std::streamsize)(values.size() * sizeof(uint32_t)));
+    }
+
+    void write_values(std::ofstream &file, std::vector<float> values) {
+        to_little_endian(values.data(), values.size());
+        file.write(reinterpret_cast<const char *>(values.data()), (std::streamsize)(values.size() * sizeof(float)));
+    }
+}
+
+bool NeuralNetwork::save_binary(const std::string &path, int n) {
+    int numNetworks = this->networks();
+    if (numNetworks <= 0) {
+        return false;
+    }
+    if (n > numNetworks) {
+        n = numNetworks;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file for writing: " << path << "\n";
+        return false;
+    }
+
+    std::vector<int> top = this->topology();
+    std::vector<uint32_t> header = {BINARY_VERSION, (uint32_t)_weights.size(), (uint32_t)n, (uint32_t)numNetworks};
+    for (int neurons : top) header.push_back((uint32_t)neurons);
+    for (auto activation : _activations) header.push_back((uint32_t)activation);
+
+    file.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    write_values(file, header);
+
+    for (size_t i = 0; i < _weights.size(); i++) {
+        // Slice out only [0..n-1] in the 3rd dimension
+        write_values(file, Utility::arrayToVector(_weights[i](af::span, af::span, af::seq(0, n - 1), af::span)));
+        write_values(file, Utility::arrayToVector(_biases[i](af::span, af::span, af::seq(0, n - 1), af::span)));
+    }
+
+    return file.good();
+}
+
+bool NeuralNetwork::load_binary(const std::string &path) {
+    MappedFile mapped(path);
+    if (!mapped.isOpen()) {
+        std::cerr << "Failed to open file for reading: " << path << "\n";
+        return false;
+    }
+
+    const unsigned char *data = mapped.data();
+    size_t size = mapped.size();
+    size_t offset = sizeof(BINARY_MAGIC);
+
+    // Reads count 4 byte values, the mapping is page aligned and every field is 4 bytes wide
+    auto read = [&](size_t count, std::vector<uint32_t> &out) -> bool {
+        if (offset + count * sizeof(uint32_t) > size) return false;
+        out.resize(count);
+        std::memcpy(out.data(), data + offset, count * sizeof(uint32_t));
+        to_little_endian(out.data(), count);
+        offset += count * sizeof(uint32_t);
+        return true;
+    };
+
+    std::vector<uint32_t> header;
+    if (size < sizeof(BINARY_MAGIC) || std::memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0 || !read(4, header)) {
+        std::cerr << "Not a network file: " << path << "\n";
+        return false;
+    }
+    if (header[0] != BINARY_VERSION) {
+        std::cerr << "Unsupported network file version " << header[0] << ": " << path << "\n";
+        return false;
+    }
+
+    if (header[1] == 0 || header[1] > BINARY_MAX_LAYERS || header[2] == 0 || header[2] > BINARY_MAX_NETWORKS ||
+        header[3] == 0 || header[3] > BINARY_MAX_NETWORKS) {
+        std::cerr << "Corrupt network file header: " << path << "\n";
+        return false;
+    }
+    int layers = (int)header[1];
+    int saved = (int)header[2];
+    int net = (int)header[3];
+
+    std::vector<uint32_t> top, activations;
+    if (!read(layers + 1, top) || !read(layers, activations)) {
+        std::cerr << "Corrupt network file header: " << path << "\n";
+        return false;
+    }
+    for (uint32_t neurons : top) {
+        if (neurons == 0 || neurons > BINARY_MAX_NEURONS) {
+            std::cerr << "Invalid layer size " << neurons << " in network file: " << path << "\n";
+            return false;
+        }
+    }
+    for (uint32_t activation : activations) {
+        if (activation > (uint32_t)Utility::Activations::Tanh) {
+            std::cerr << "Unknown activation " << activation << " in network file: " << path << "\n";
+            return false;
+        }
+    }
+
+    // The whole payload has to be present before anything is allocated
+    size_t payload = 0;
+    for (int i = 0; i < layers; ++i) {
+        size_t weightCount, biasCount, layerBytes;
+        if (!multiply_size((size_t)top[i + 1], (size_t)top[i], weightCount) ||
+            !multiply_size(weightCount, (size_t)saved, weightCount) ||
+            !multiply_size((size_t)top[i + 1], (size_t)saved, biasCount) ||
+            weightCount > SIZE_MAX - biasCount ||
+            !multiply_size(weightCount + biasCount, sizeof(float), layerBytes) ||
+            layerBytes > SIZE_MAX - payload) {
+            std::cerr << "Corrupt network file header: " << path << "\n";
+            return false;
+        }
+        payload += layerBytes;
+    }
+    if (payload > size - offset) {
+        std::cerr << "Network file is truncated: " << path << "\n";
+        return false;
+    }
+
+    int networks = _weights.empty() ? net : (int)_weights[0].dims(2);
+
+    std::vector<af::array> loadedWeights;
+    std::vector<af::array> loadedBiases;
+    std::vector<float> swapped;
+    for (int i = 0; i < layers; ++i) {
+        dim_t rows = top[i + 1];
+        dim_t cols = top[i];
+        size_t weightCount = (size_t)rows * cols * saved;
+        size_t biasCount = (size_t)rows * saved;
+
+        // The floats are copied from the mapping straight into the arrays
+        auto blob = [&](size_t count) -> const float * {
+            const float *values = reinterpret_cast<const float *>(data + offset);
+            offset += count * sizeof(float);
+            if (host_is_little_endian()) return values;
+
+            swapped.assign(values, values + count);
+            to_little_endian(swapped.data(), count);
+            return swapped.data();
+        };
+
+        af::array wArr(rows, cols, saved, 1, blob(weightCount));
+        af::array bArr(rows, 1, saved, 1, blob(biasCount));
+
+        if (net > saved) {
+            wArr = repeat_networks(wArr, networks);
+            bArr = repeat_networks(bArr, networks);
+        }
+        loadedWeights.push_back(wArr);
+        loadedBiases.push_back(bArr);
+    }
+
+    _weights = loadedWeights;
+    _biases = loadedBiases;
+    _activations.clear();
+    for (uint32_t activation : activations) {
+        _activations.push_back(static_cast<Utility::Activations>(activation));
+    }
+    _hostDirty = true;
 
     return true;
 }
@@ -14,6 +14,8 @@
 #include "../vendors/json/json.hpp"
 
 #include "../Utility/Utility.h"
+#include "../Utility/MappedFile.h"
+#include "../Selection/Selection.h"
 
 class NeuralNetwork {
 private:
@@ -22,6 +24,31 @@ private:
     std::vector<af::array> _biases;
     std::vector<Utility::Activations> _activations;
 
+    // Host copy of the weights for feed_forward_host, element (row, column) of all networks is contiguous
+    std::vector<std::vector<float>> _hostWeights;
+    std::vector<std::vector<float>> _hostBiases;
+    std::vector<int> _hostTopology;
+    int _hostNetworks = 0;
+    bool _hostDirty = true;
+
+    // Second set of weights the children are written into by breed, swapped with the current one afterwards
+    std::vector<af::array> _weightsBack;
+    std::vector<af::array> _biasesBack;
+    af::randomEngine _engine{AF_RANDOM_ENGINE_DEFAULT, std::random_device{}()};
+
+    // Repeats the saved networks along the 3rd dimension until there are as many as networks
+    static af::array repeat_networks(const af::array &saved, int networks);
+    static bool is_binary_path(const std::string &path);
+
+    bool save_json(const std::string &path, int amount);
+    bool load_json(const std::string &path);
+    bool save_binary(const std::string &path, int amount);
+    bool load_binary(const std::string &path);
+
+    // Copies the elites and crosses the parent pairs into the back buffers, then swaps them in
+    void breed(const af::array &selectedIdx, const af::array &n1Array, const af::array &n2Array,
+               float min, float max, bool uniform);
+
 public:
     // Constructors
     NeuralNetwork() = default;
@@ -31,14 +58,16 @@ public:
     NeuralNetwork(std::string path);
 
     // Getter and setter
-    [[nodiscard]] std::vector<af::array> &weights() { return _weights; }
-    [[nodiscard]] std::vector<af::array> &biases() { return _biases; }
+    // The references allow changes, so the host copy is refreshed on the next feed_forward_host
+    [[nodiscard]] std::vector<af::array> &weights() { _hostDirty = true; return _weights; }
+    [[nodiscard]] std::vector<af::array> &biases() { _hostDirty = true; return _biases; }
     [[nodiscard]] std::vector<Utility::Activations> &activationValues() { return _activations; }
-    [[nodiscard]] af::array &weights(int i) { return _weights[i]; }
-    [[nodiscard]] af::array &biases(int i) { return _biases[i]; }
+    [[nodiscard]] af::array &weights(int i) { _hostDirty = true; return _weights[i]; }
+    [[nodiscard]] af::array &biases(int i) { _hostDirty = true; return _biases[i]; }
     [[nodiscard]] Utility::Activations &activations(int i) { return _activations[i]; }
 
     // Functions
+    // Files ending in ".bin" use the binary format, everything else JSON
     bool load(std::string path);
     bool save(std::string path, int amount = 1);
     int networks();
@@ -47,13 +76,48 @@ public:
     std::vector<int> topology();
 
     af::array feed_forward(af::array &input);
+    // Only the networks listed in the integer array networks, input is (inputs, 1, networks.elements())
+    af::array feed_forward(af::array &input, const af::array &networks);
+    // Previous implementation that tiles the weights for every batch entry, kept for comparisons
+    af::array feed_forward_tiled(af::array &input);
     af::array feed_forward(std::vector<float> &input);
 
+    // Evaluates all networks on the CPU without ArrayFire calls. Input and output have the layout of
+    // feed_forward: (inputs, 1, networks) and (outputs, 1, networks), column major.
+    void feed_forward_host(const float *input, float *output);
+    // Only networks [begin, end), may run in parallel for disjoint ranges once sync_host was called
+    void feed_forward_host(const float *input, float *output, int begin, int end);
+    // Only the networks indices[begin, end), input and output keep the full layout above
+    void feed_forward_host(const float *input, float *output, const int *indices, int begin, int end);
+    void sync_host();
+    // Largest absolute difference between feed_forward and feed_forward_host for the input, indexed variants included
+    float host_deviation(af::array &input);
+    // Builds networks with random weights, compares both paths on inputs in the range of ray distances and prints the result
+    static bool verify_host_inference(std::vector<int> &topology, std::vector<Utility::Activations> &activations,
+                                      float randomMax, bool uniform, int networks, float tolerance);
+
     af::array feed_forward_single(af::array &input, int index);
     af::array feed_forward_single(std::vector<float> &input, int index);
 
+    // Selection, crossover and mutation run on the device, the fitness stays there as well
     void breed(af::array &fitness, int winners, float min, float max, bool uniform = true);
     void breed(std::vector<float> &fitness, int winners, float min, float max, bool uniform = true);
+    // Elites and parent pairs chosen on the host by the strategy, crossover and mutation on the device
+    void breed(std::vector<float> &fitness, SelectionStrategy &strategy, int elites, float min, float max,
+               bool uniform = true);
+    void seed(unsigned long long value) { _engine.setSeed(value); }
+    // Draws all weights and biases again from the engine, reproducible after seed
+    void randomize(float min, float max, bool uniform = true);
+
+    // All weights and then all biases of one network, layer by layer, used to move networks between populations
+    std::vector<float> get_genome(int index);
+    void set_genome(int index, const std::vector<float> &genome);
+
+    // Networks [begin, end) in the layout of the binary file: per layer the weights, then the biases,
+    // each column major like the ArrayFire arrays
+    std::vector<float> export_networks(int begin, int end);
+    // Replaces all networks, their count follows from the size and the current topology
+    bool import_networks(const float *data, size_t size);
 };
 
 
@@ -0,0 +1,149 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#include "Selection.h"
+
+#include <algorithm>
+#include <numeric>
+#include <iostream>
+
+std::vector<unsigned int> SelectionStrategy::top_n(const std::vector<float> &fitness, int n) {
+    n = std::min(n, (int)fitness.size());
+    if (n <= 0) return {};
+
+    std::vector<unsigned int> indices(fitness.size());
+    std::iota(indices.begin(), indices.end(), 0u);
+
+    auto better = [&fitness](unsigned int a, unsigned int b) { return fitness[a] > fitness[b]; };
+    std::nth_element(indices.begin(), indices.begin() + (n - 1), indices.end(), better);
+    indices.resize(n);
+    std::sort(indices.begin(), indices.end(), better);
+    return indices;
+}
+
+unsigned int SelectionStrategy::random_index(unsigned int size) {
+    return std::uniform_int_distribution<unsigned int>(0, size - 1)(_rng);
+}
+
+unsigned int SelectionStrategy::tournament(const std::vector<float> &fitness, int size) {
+    unsigned int best = random_index((unsigned int)fitness.size());
+    for (int i = 1; i < size; ++i) {
+        unsigned int contender = random_index((unsigned int)fitness.size());
+        if (fitness[contender] > fitness[best]) best = contender;
+    }
+    return best;
+}
+
+std::unique_ptr<SelectionStrategy> SelectionStrategy::create(const std::string &name, int tournamentSize, float rankPressure) {
+    if (name == "truncation") return std::make_unique<TruncationSelection>();
+    if (name == "tournament") return std::make_unique<TournamentSelection>(tournamentSize);
+    if (name == "elitist_tournament") return std::make_unique<ElitistTournamentSelection>(tournamentSize);
+    if (name == "proportional") return std::make_unique<ProportionalSelection>();
+    if (name == "rank") return std::make_unique<RankSelection>(rankPressure);
+
+    std::cerr << "Unknown selection strategy " << name << ", using truncation\n";
+    return std::make_unique<TruncationSelection>();
+}
+
+void TruncationSelection::select(const std::vector<float> &fitness, int elites, int pairs, Selection &out) {
+    out.elites = top_n(fitness, std::max(elites, 1));
+    out.parents1.resize(pairs);
+    out.parents2.resize(pairs);
+
+    auto winners = (unsigned int)out.elites.size();
+    for (int i = 0; i < pairs; ++i) {
+        out.parents1[i] = out.elites[random_index(winners)];
+        out.parents2[i] = out.elites[random_index(winners)];
+    }
+
+    // Without elites the winners were only needed as parents
+    if (elites <= 0) out.elites.clear();
+}
+
+void TournamentSelection::select(const std::vector<float> &fitness, int elites, int pairs, Selection &out) {
+    // Pure tournament keeps nothing, the elite slots are filled with children as well
+    int children = elites + pairs;
+
+    out.elites.clear();
+    out.parents1.resize(children);
+    out.parents2.resize(children);
+    for (int i = 0; i < children; ++i) {
+        out.parents1[i] = tournament(fitness, _size);
+        out.parents2[i] = tournament(fitness, _size);
+    }
+}
+
+void ElitistTournamentSelection::select(const std::vector<float> &fitness, int elites, int pairs, Selection &out) {
+    TournamentSelection::select(fitness, 0, pairs, out);
+    out.elites = top_n(fitness, elites);
+}
+
+void ProportionalSelection::build_alias_table(const std::vector<float> &fitness) {
+    size_t n = fitness.size();
+    float worst = *std::min_element(fitness.begin(), fitness.end());
+
+    // Shift so the worst network has a small chance as well, negative scores are common
+    std::vector<double> scaled(n);
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        scaled[i] = (double)fitness[i] - worst + 1e-3;
+        sum += scaled[i];
+    }
+
+    // Vose's alias method
+    _probability.assign(n, 1.0f);
+    _alias.resize(n);
+    std::iota(_alias.begin(), _alias.end(), 0u);
+
+    std::vector<unsigned int> small, large;
+    for (size_t i = 0; i < n; ++i) {
+        scaled[i] *= (double)n / sum;
+        (scaled[i] < 1.0 ? small : large).push_back((unsigned int)i);
+    }
+
+    while (!small.empty() && !large.empty()) {
+        unsigned int s = small.back(); small.pop_back();
+        unsigned int l = large.back(); large.pop_back();
+
+        _probability[s] = (float)scaled[s];
+        _alias[s] = l;
+
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+        (scaled[l] < 1.0 ? small : large).push_back(l);
+    }
+    // Leftovers are 1 up to rounding errors
+}
+
+unsigned int ProportionalSelection::sample() {
+    unsigned int column = random_index((unsigned int)_probability.size());
+    float coin = std::uniform_real_distribution<float>(0.0f, 1.0f)(_rng);
+    return coin < _probability[column] ? column : _alias[column];
+}
+
+void ProportionalSelection::select(const std::vector<float> &fitness, int elites, int pairs, Selection &out) {
+    build_alias_table(fitness);
+
+    out.elites = top_n(fitness, elites);
+    out.parents1.resize(pairs);
+    out.parents2.resize(pairs);
+    for (int i = 0; i < pairs; ++i) {
+        out.parents1[i] = sample();
+        out.parents2[i] = sample();
+    }
+}
+
+unsigned int RankSelection::sample(const std::vector<float> &fitness) {
+    float coin = std::uniform_real_distribution<float>(0.0f, 1.0f)(_rng);
+    return coin < _pressure - 1.0f ? tournament(fitness, 2) : random_index((unsigned int)fitness.size());
+}
+
+void RankSelection::select(const std::vector<float> &fitness, int elites, int pairs, Selection &out) {
+    out.elites = top_n(fitness, elites);
+    out.parents1.resize(pairs);
+    out.parents2.resize(pairs);
+    for (int i = 0; i < pairs; ++i) {
+        out.parents1[i] = sample(fitness);
+        out.parents2[i] = sample(fitness);
+    }
+}
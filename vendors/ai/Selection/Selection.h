@@ -0,0 +1,91 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef MATURAPROJEKT_SELECTION_H
+#define MATURAPROJEKT_SELECTION_H
+
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <memory>
+#include <string>
+
+// Result of a selection: networks copied unchanged and the parents of every child, all network indices
+struct Selection {
+    std::vector<unsigned int> elites;
+    std::vector<unsigned int> parents1;
+    std::vector<unsigned int> parents2;
+};
+
+class SelectionStrategy {
+protected:
+    std::mt19937 _rng{std::random_device{}()};
+
+    // Indices of the n best values, best first. O(N) partition plus sorting the n winners.
+    static std::vector<unsigned int> top_n(const std::vector<float> &fitness, int n);
+
+    [[nodiscard]] unsigned int random_index(unsigned int size);
+    // Best of size random networks
+    [[nodiscard]] unsigned int tournament(const std::vector<float> &fitness, int size);
+
+public:
+    virtual ~SelectionStrategy() = default;
+
+    virtual void select(const std::vector<float> &fitness, int elites, int pairs, Selection &out) = 0;
+
+    void seed(unsigned int value) { _rng.seed(value); }
+
+    // "truncation", "tournament", "proportional", "rank" or "elitist_tournament"
+    static std::unique_ptr<SelectionStrategy> create(const std::string &name, int tournamentSize = 3,
+                                                     float rankPressure = 1.5f);
+};
+
+// The elites are the only parents, pairs are drawn uniformly from them
+class TruncationSelection : public SelectionStrategy {
+public:
+    void select(const std::vector<float> &fitness, int elites, int pairs, Selection &out) override;
+};
+
+// Every parent is the best of a few random networks, nothing is copied unchanged
+class TournamentSelection : public SelectionStrategy {
+private:
+    int _size;
+public:
+    explicit TournamentSelection(int size) : _size(std::max(1, size)) {}
+    void select(const std::vector<float> &fitness, int elites, int pairs, Selection &out) override;
+};
+
+// Tournament parents, the elites are kept as well
+class ElitistTournamentSelection : public TournamentSelection {
+public:
+    explicit ElitistTournamentSelection(int size) : TournamentSelection(size) {}
+    void select(const std::vector<float> &fitness, int elites, int pairs, Selection &out) override;
+};
+
+// Probability proportional to the fitness above the worst network, sampled in O(1) from an alias table
+class ProportionalSelection : public SelectionStrategy {
+private:
+    std::vector<float> _probability;
+    std::vector<unsigned int> _alias;
+
+    void build_alias_table(const std::vector<float> &fitness);
+    [[nodiscard]] unsigned int sample();
+public:
+    void select(const std::vector<float> &fitness, int elites, int pairs, Selection &out) override;
+};
+
+// Linear ranking without sorting. The better of two random networks is picked with probability
+// (2 * rank - 1) / N^2 (rank 1 is the worst), which is linear ranking with pressure 2. Mixing it with
+// uniform picks lowers the pressure to anything between 1 and 2.
+class RankSelection : public SelectionStrategy {
+private:
+    float _pressure;
+
+    [[nodiscard]] unsigned int sample(const std::vector<float> &fitness);
+public:
+    explicit RankSelection(float pressure = 1.5f) : _pressure(std::clamp(pressure, 1.0f, 2.0f)) {}
+    void select(const std::vector<float> &fitness, int elites, int pairs, Selection &out) override;
+};
+
+#endif //MATURAPROJEKT_SELECTION_H
@@ -0,0 +1,40 @@
+//
+// Created by Tobias on 17.10.2026.
+//
+
+#ifndef MATURAPROJEKT_MAPPEDFILE_H
+#define MATURAPROJEKT_MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+// Read only memory mapping of a whole file, unmapped on destruction
+class MappedFile {
+private:
+    const unsigned char *_data = nullptr;
+    size_t _size = 0;
+
+#ifdef _WIN32
+    void *_file = nullptr;
+    void *_mapping = nullptr;
+#else
+    int _file = -1;
+#endif
+
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string &path) { open(path); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool open(const std::string &path);
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return _data != nullptr; }
+    [[nodiscard]] const unsigned char *data() const { return _data; }
+    [[nodiscard]] size_t size() const { return _size; }
+};
+
+#endif //MATURAPROJEKT_MAPPEDFILE_H
@@ -3,6 +3,7 @@
 //
 
 #include "Utility.h"
+#include <cmath>
 #ifdef max
 #undef max
 #endif
@@ -73,6 +74,25 @@ af::array Utility::calculate_activation(af::array &values, Activations activatio
     }
 }
 
+void Utility::calculate_activation(float *values, size_t count, Activations activation) {
+    switch(activation) {
+        case Activations::Sigmoid:
+            for (size_t i = 0; i < count; ++i) values[i] = 1.0f / (1.0f + std::exp(-values[i]));
+            break;
+        case Activations::LeakyReLU:
+            for (size_t i = 0; i < count; ++i) values[i] = values[i] > 0 ? values[i] : 0.1f * values[i];
+            break;
+        case Activations::ReLU:
+            for (size_t i = 0; i < count; ++i) values[i] = std::max(values[i], 0.0f);
+            break;
+        case Activations::Tanh:
+            for (size_t i = 0; i < count; ++i) values[i] = std::tanh(values[i]);
+            break;
+        default:
+            break;
+    }
+}
+
 std::vector<float> Utility::arrayToVector(const af::array &array) {
     std::size_t numElements = array.elements();
 
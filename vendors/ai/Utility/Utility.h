@@ -31,6 +31,8 @@ public:
 
     // Calculate activation
     static af::array calculate_activation(af::array &values, Activations activation, bool derivative = false);
+    // Same activations on host memory, in place
+    static void calculate_activation(float *values, size_t count, Activations activation);
 
     // Conversion functions for af::array
     static af::array vectorToArray(std::vector<float> const &vector);